@@ -0,0 +1,47 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "verilator_chip_sim.h"
+
+#include <iostream>
+#include <memory>
+
+#include "mem_area.h"
+#include "verilator_memutil.h"
+#include "verilator_sim_ctrl.h"
+
+int ChipSimMain(const ChipSimConfig &config, VerilatedToplevel *top,
+                CData *sig_clk, CData *sig_rst_n, int argc, char **argv) {
+  VerilatorMemUtil memutil;
+  VerilatorSimCtrl &simctrl = VerilatorSimCtrl::GetInstance();
+  simctrl.SetTop(top, sig_clk, sig_rst_n,
+                 VerilatorSimCtrlFlags::ResetPolarityNegative);
+
+  // The memory areas must outlive the simulation, since memutil only holds
+  // pointers to them.
+  std::vector<std::unique_ptr<MemArea>> mem_areas;
+  for (const ChipSimMemory &mem : config.memories) {
+    mem_areas.emplace_back(new MemArea(config.top_scope + "." + mem.scope,
+                                       mem.size_bytes / mem.width_bytes,
+                                       mem.width_bytes));
+    const MemArea &mem_area = *mem_areas.back();
+    if (mem.erased) {
+      // Future loads can overwrite this.
+      std::vector<uint8_t> all_ones(mem_area.GetSizeBytes(), 0xffu);
+      mem_area.Write(/*word_offset=*/0, all_ones);
+    }
+    memutil.RegisterMemoryArea(mem.name, mem.base, &mem_area);
+  }
+  simctrl.RegisterExtension(&memutil);
+
+  simctrl.SetInitialResetDelay(config.initial_reset_delay);
+  simctrl.SetResetDuration(config.reset_duration);
+
+  std::string title = "Simulation of OpenTitan " + config.title;
+  std::cout << title << std::endl
+            << std::string(title.size(), '=') << std::endl
+            << std::endl;
+
+  return simctrl.Exec(argc, argv).first;
+}
@@ -0,0 +1,58 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+#ifndef OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_CHIP_SIM_H_
+#define OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_CHIP_SIM_H_
+
+//
+// A simulation driver shared by the chip-level Verilator harnesses of the
+// different toplevels.
+//
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "verilated_toplevel.h"
+
+// A memory of the toplevel that can be preloaded from the command line, e.g.
+// with --rominit or --load-elf (see VerilatorMemUtil).
+struct ChipSimMemory {
+  // Name of the memory, as used by --meminit.
+  std::string name;
+  // Base address of the memory. ELF segments are placed by LMA.
+  uint32_t base;
+  // Scope of the memory, relative to the toplevel scope.
+  std::string scope;
+  // Size of the memory in bytes.
+  uint32_t size_bytes;
+  // Width of a memory word in bytes.
+  uint32_t width_bytes;
+  // If true, the memory is filled with ones before any image is loaded, as an
+  // erased flash would be.
+  bool erased;
+};
+
+// Description of a toplevel for ChipSimMain().
+struct ChipSimConfig {
+  // Name of the toplevel, printed when the simulation starts.
+  std::string title;
+  // Scope of the toplevel instance in the verilated model.
+  std::string top_scope;
+  // Memories that can be preloaded.
+  std::vector<ChipSimMemory> memories;
+  // Default number of cycles before reset is asserted. This can be overridden
+  // with --initial-reset-delay.
+  unsigned int initial_reset_delay;
+  // Number of cycles reset is asserted for.
+  unsigned int reset_duration;
+};
+
+// Registers the memories of the toplevel described by `config`, then parses
+// the command line and runs the simulation of `top`.
+//
+// Returns a main()-compatible process exit code.
+int ChipSimMain(const ChipSimConfig &config, VerilatedToplevel *top,
+                CData *sig_clk, CData *sig_rst_n, int argc, char **argv);
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_CHIP_SIM_H_
@@ -110,6 +110,7 @@ static bool read_ul_arg(unsigned long *arg_val, const char *arg_name,
 bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
   const struct option long_options[] = {
       {"term-after-cycles", required_argument, nullptr, 'c'},
+      {"initial-reset-delay", required_argument, nullptr, 'R'},
       {"trace", no_argument, nullptr, 't'},
       {"help", no_argument, nullptr, 'h'},
       {nullptr, no_argument, nullptr, 0}};
@@ -142,6 +143,15 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
           return false;
         }
         break;
+      case 'R': {
+        unsigned long cycles;
+        if (!read_ul_arg(&cycles, "initial-reset-delay", optarg)) {
+          exit_app = true;
+          return false;
+        }
+        initial_reset_delay_cycles_ = cycles;
+        break;
+      }
       case 'h':
         PrintHelp();
         exit_app = true;
@@ -273,6 +283,10 @@ void VerilatorSimCtrl::PrintHelp() const {
   }
   std::cout << "-c|--term-after-cycles=N\n"
                "  Terminate simulation after N cycles. 0 means no timeout.\n\n"
+               "--initial-reset-delay=N\n"
+               "  Assert reset after N cycles instead of the toplevel's\n"
+               "  default. Use a small N to skip the delay when the design\n"
+               "  does not need it.\n\n"
                "-h|--help\n"
                "  Show help\n\n"
                "All arguments are passed to the design and can be used "
@@ -89,6 +89,9 @@ class VerilatorSimCtrl {
   /**
    * Set the number of clock cycles (periods) before the reset signal is
    * activated
+   *
+   * This can be overridden by the user with the --initial-reset-delay
+   * command-line argument.
    */
   void SetInitialResetDelay(unsigned int cycles);
 
@@ -13,6 +13,34 @@
 #include "crypto.h"
 #include "svdpi.h"
 
+/**
+ * Get an expanded key for the C model.
+ *
+ * The key is only expanded again if it differs from the one of the previous
+ * call, as scoreboards typically process many blocks with the same key.
+ *
+ * @param  key     Encryption key
+ * @param  key_len Key length in bytes (16, 24, 32)
+ * @return Pointer to the context holding the expanded key, NULL on error
+ */
+static const aes_ctx_t *aes_model_ctx_get(const unsigned char *key,
+                                          int key_len) {
+  static aes_ctx_t ctx;
+  static unsigned char ctx_key[32];
+  static int ctx_key_len = 0;
+
+  if (key_len != ctx_key_len || memcmp(key, ctx_key, key_len)) {
+    if (aes_ctx_init(&ctx, key, key_len)) {
+      ctx_key_len = 0;
+      return NULL;
+    }
+    memcpy(ctx_key, key, key_len);
+    ctx_key_len = key_len;
+  }
+
+  return &ctx;
+}
+
 void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
                            const svBitVecVal *mode_i, const svBitVecVal *iv_i,
                            const svBitVecVal *key_len_i,
@@ -58,6 +86,8 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
     // The C model does ECB only. We "emulate" other modes here.
     unsigned char data_in[16];
     unsigned char data_out[16];
+    const aes_ctx_t *ctx = aes_model_ctx_get(key, key_len);
+    assert(ctx);
 
     if (mode == kCryptoAesCbc) {
       if (!op) {
@@ -65,9 +95,9 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
         for (int i = 0; i < 16; ++i) {
           data_in[i] = ref_in[i] ^ iv[i];
         }
-        aes_encrypt_block(data_in, key, key_len, ref_out);
+        aes_ctx_encrypt_block(ctx, data_in, ref_out);
       } else {
-        aes_decrypt_block(ref_in, key, key_len, data_out);
+        aes_ctx_decrypt_block(ctx, ref_in, data_out);
         // ref_out = data_out XOR iv (or previous data_out)
         for (int i = 0; i < 16; ++i) {
           ref_out[i] = data_out[i] ^ iv[i];
@@ -78,7 +108,7 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
       for (int i = 0; i < 16; ++i) {
         data_in[i] = iv[i];
       }
-      aes_encrypt_block(data_in, key, key_len, data_out);
+      aes_ctx_encrypt_block(ctx, data_in, data_out);
       // ref_out = data_out XOR ref_in
       for (int i = 0; i < 16; ++i) {
         ref_out[i] = data_out[i] ^ ref_in[i];
@@ -88,15 +118,15 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
       for (int i = 0; i < 16; ++i) {
         data_in[i] = iv[i];
       }
-      aes_encrypt_block(data_in, key, key_len, data_out);
+      aes_ctx_encrypt_block(ctx, data_in, data_out);
       for (int i = 0; i < 16; ++i) {
         ref_out[i] = data_out[i] ^ ref_in[i];
       }
     } else {  // ECB
       if (!op) {
-        aes_encrypt_block(ref_in, key, key_len, ref_out);
+        aes_ctx_encrypt_block(ctx, ref_in, ref_out);
       } else {
-        aes_decrypt_block(ref_in, key, key_len, ref_out);
+        aes_ctx_decrypt_block(ctx, ref_in, ref_out);
       }
     }
   } else {  // OpenSSL/BoringSSL
@@ -144,14 +174,6 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
     key_len = 32;
   }
 
-  if (impl == 0) {
-    // The C model is currently not supported.
-    printf(
-        "ERROR: c_dpi_aes_crypt_message() currently supports OpenSSL/BoringSSL "
-        "only\n");
-    return;
-  }
-
   // Get key from simulator.
   unsigned char *key = aes_key_get(key_i);
 
@@ -192,10 +214,10 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
   }
 
   if (impl == 0) {
-    // The C model is currently not supported.
-    printf(
-        "ERROR: c_dpi_aes_crypt_message() currently supports OpenSSL/BoringSSL "
-        "only\n");
+    // The C model processes the message in place and updates the IV.
+    const aes_ctx_t *ctx = aes_model_ctx_get(key, key_len);
+    assert(ctx);
+    aes_crypt(ctx, mode, op, iv, ref_in, data_len, ref_out);
   } else {  // OpenSSL/BoringSSL
     if (!op) {
       crypto_encrypt(ref_out, iv, ref_in, data_len, key, key_len, mode);
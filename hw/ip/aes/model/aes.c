@@ -7,55 +7,17 @@
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
                       const int key_len, unsigned char *cipher_text) {
-  int num_rounds = aes_get_num_rounds(key_len);
-  if (num_rounds < 0) {
-    printf("ERROR: aes_get_num_rounds() failed\n");
+  aes_ctx_t ctx;
+  if (aes_ctx_init(&ctx, key, key_len)) {
+    printf("ERROR: aes_ctx_init() failed\n");
     return -EINVAL;
   }
 
-  unsigned char rcon;
-  unsigned char state[16];
-  unsigned char round_key[16];
-  unsigned char *full_key =
-      (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (full_key == NULL) {
-    printf("ERROR: malloc() failed\n");
-    return -ENOMEM;
-  }
-
-  // init
-  for (int i = 0; i < 16; i++) {
-    state[i] = plain_text[i];
-  }
-  for (int i = 0; i < key_len; i++) {
-    full_key[i] = key[i];
-  }
-  for (int i = 0; i < 16; i++) {
-    round_key[i] = full_key[i];
-  }
-  rcon = 0;
-
-  // ecnrypt
-  aes_add_round_key(state, round_key);
-  for (int j = 0; j < num_rounds; j++) {
-    aes_sub_bytes(state);
-    aes_shift_rows(state);
-    if (j < (num_rounds - 1)) {
-      aes_mix_columns(state);
-    }
-    aes_key_expand(round_key, full_key, key_len, &rcon, j);
-    aes_add_round_key(state, round_key);
-  }
-
-  // finish
-  for (int i = 0; i < 16; i++) {
-    cipher_text[i] = state[i];
-  }
-
-  free(full_key);
+  aes_ctx_encrypt_block(&ctx, plain_text, cipher_text);
 
   return 0;
 }
@@ -63,61 +25,14 @@ int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
 int aes_decrypt_block(const unsigned char *cipher_text,
                       const unsigned char *key, const int key_len,
                       unsigned char *plain_text) {
-  int num_rounds = aes_get_num_rounds(key_len);
-  if (num_rounds < 0) {
-    printf("ERROR: aes_get_num_rounds() failed\n");
+  aes_ctx_t ctx;
+  if (aes_ctx_init(&ctx, key, key_len)) {
+    printf("ERROR: aes_ctx_init() failed\n");
     return -EINVAL;
   }
 
-  unsigned char rcon;
-  unsigned char state[16];
-  unsigned char round_key[16];
-  unsigned char *full_key =
-      (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (full_key == NULL) {
-    printf("ERROR: malloc() failed\n");
-    return -ENOMEM;
-  }
-
-  // init
-  for (int i = 0; i < 16; i++) {
-    state[i] = cipher_text[i];
-  }
-  for (int i = 0; i < key_len; i++) {
-    full_key[i] = key[i];
-  }
-  for (int i = 0; i < 16; i++) {
-    round_key[i] = full_key[i];
-  }
-  rcon = 0;
-
-  // get decryption start key
-  for (int j = 0; j < num_rounds; j++) {
-    aes_key_expand(round_key, full_key, key_len, &rcon, j);
-  }
-  rcon = 0;
+  aes_ctx_decrypt_block(&ctx, cipher_text, plain_text);
 
-  // decrypt - using Equivalent Inverse Cipher
-  aes_add_round_key(state, round_key);
-  for (int j = 0; j < num_rounds; j++) {
-    aes_inv_sub_bytes(state);
-    aes_inv_shift_rows(state);
-    if (j < (num_rounds - 1)) {
-      aes_inv_mix_columns(state);
-    }
-    aes_inv_key_expand(round_key, full_key, key_len, &rcon, j);
-    if (j < (num_rounds - 1)) {
-      aes_inv_mix_columns(round_key);
-    }
-    aes_add_round_key(state, round_key);
-  }
-
-  // finish
-  for (int i = 0; i < 16; i++) {
-    plain_text[i] = state[i];
-  }
-
-  free(full_key);
   return 0;
 }
 
@@ -187,6 +102,268 @@ static unsigned char aes_mul4(unsigned char in) {
   return out;
 }
 
+static unsigned char aes_mul(unsigned char a, unsigned char b) {
+  unsigned char out = 0x0;
+
+  // shift-and-add multiplication in GF(2^8)
+  while (b) {
+    if (b & 0x1) {
+      out ^= a;
+    }
+    a = aes_mul2(a);
+    b >>= 1;
+  }
+
+  return out;
+}
+
+static uint32_t aes_rotl8(uint32_t x) { return (x << 8) | (x >> 24); }
+
+// T-tables combining SubBytes and MixColumns (te) and their inverses (td) for
+// one state byte. Table k holds the contribution of row k to a column, i.e.,
+// table k is table 0 rotated by k bytes. Generated on first use.
+static uint32_t te[4][256];
+static uint32_t td[4][256];
+static int ttables_ready = 0;
+
+static void aes_ttables_init(void) {
+  if (ttables_ready) {
+    return;
+  }
+
+  for (int i = 0; i < 256; i++) {
+    unsigned char s = sbox[i];
+    unsigned char is = inv_sbox[i];
+    // MixColumns / InvMixColumns matrix column 0 is {2, 1, 1, 3} /
+    // {e, 9, d, b}.
+    te[0][i] = (uint32_t)aes_mul2(s) | (uint32_t)s << 8 | (uint32_t)s << 16 |
+               (uint32_t)(aes_mul2(s) ^ s) << 24;
+    td[0][i] = (uint32_t)aes_mul(is, 0xe) | (uint32_t)aes_mul(is, 0x9) << 8 |
+               (uint32_t)aes_mul(is, 0xd) << 16 |
+               (uint32_t)aes_mul(is, 0xb) << 24;
+    for (int k = 1; k < 4; k++) {
+      te[k][i] = aes_rotl8(te[k - 1][i]);
+      td[k][i] = aes_rotl8(td[k - 1][i]);
+    }
+  }
+
+  ttables_ready = 1;
+}
+
+static uint32_t aes_load_word(const unsigned char *in) {
+  return (uint32_t)in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 |
+         (uint32_t)in[3] << 24;
+}
+
+static void aes_store_word(uint32_t w, unsigned char *out) {
+  out[0] = w & 0xff;
+  out[1] = (w >> 8) & 0xff;
+  out[2] = (w >> 16) & 0xff;
+  out[3] = w >> 24;
+}
+
+static uint32_t aes_sub_word(uint32_t w) {
+  return (uint32_t)sbox[w & 0xff] | (uint32_t)sbox[(w >> 8) & 0xff] << 8 |
+         (uint32_t)sbox[(w >> 16) & 0xff] << 16 |
+         (uint32_t)sbox[w >> 24] << 24;
+}
+
+static uint32_t aes_inv_mix_column(uint32_t w) {
+  // InvMixColumns(w) = td(sbox(w)) since td includes the inverse S-Box.
+  return td[0][sbox[w & 0xff]] ^ td[1][sbox[(w >> 8) & 0xff]] ^
+         td[2][sbox[(w >> 16) & 0xff]] ^ td[3][sbox[w >> 24]];
+}
+
+int aes_ctx_init(aes_ctx_t *ctx, const unsigned char *key, const int key_len) {
+  int num_rounds = aes_get_num_rounds(key_len);
+  if (num_rounds < 0) {
+    printf("ERROR: aes_get_num_rounds() failed\n");
+    return -EINVAL;
+  }
+
+  aes_ttables_init();
+  ctx->num_rounds = num_rounds;
+
+  // key expansion, FIPS 197 Section 5.2
+  uint32_t *w = ctx->enc_round_keys;
+  const int num_k = key_len / 4;
+  const int num_words = 4 * (num_rounds + 1);
+  unsigned char rcon = 0;
+  for (int i = 0; i < num_k; i++) {
+    w[i] = aes_load_word(&key[4 * i]);
+  }
+  for (int i = num_k; i < num_words; i++) {
+    uint32_t temp = w[i - 1];
+    if (i % num_k == 0) {
+      aes_rcon_next(&rcon);
+      // RotWord moves byte 1 to byte 0, i.e., rotates right by 8 bits here.
+      temp = aes_sub_word((temp >> 8) | (temp << 24)) ^ rcon;
+    } else if (num_k > 6 && i % num_k == 4) {
+      temp = aes_sub_word(temp);
+    }
+    w[i] = w[i - num_k] ^ temp;
+  }
+
+  // decryption round keys for the Equivalent Inverse Cipher, FIPS 197
+  // Section 5.3.5
+  uint32_t *dw = ctx->dec_round_keys;
+  for (int rnd = 0; rnd <= num_rounds; rnd++) {
+    for (int c = 0; c < 4; c++) {
+      uint32_t rk = w[4 * (num_rounds - rnd) + c];
+      if (rnd > 0 && rnd < num_rounds) {
+        rk = aes_inv_mix_column(rk);
+      }
+      dw[4 * rnd + c] = rk;
+    }
+  }
+
+  return 0;
+}
+
+void aes_ctx_encrypt_block(const aes_ctx_t *ctx,
+                           const unsigned char *plain_text,
+                           unsigned char *cipher_text) {
+  const uint32_t *rk = ctx->enc_round_keys;
+  uint32_t s[4], t[4];
+
+  for (int c = 0; c < 4; c++) {
+    s[c] = aes_load_word(&plain_text[4 * c]) ^ rk[c];
+  }
+
+  // SubBytes, ShiftRows and MixColumns: row r of output column c comes from
+  // input column c + r.
+  for (int rnd = 1; rnd < ctx->num_rounds; rnd++) {
+    rk += 4;
+    for (int c = 0; c < 4; c++) {
+      t[c] = te[0][s[c] & 0xff] ^ te[1][(s[(c + 1) & 3] >> 8) & 0xff] ^
+             te[2][(s[(c + 2) & 3] >> 16) & 0xff] ^
+             te[3][s[(c + 3) & 3] >> 24] ^ rk[c];
+    }
+    for (int c = 0; c < 4; c++) {
+      s[c] = t[c];
+    }
+  }
+
+  // final round without MixColumns
+  rk += 4;
+  for (int c = 0; c < 4; c++) {
+    t[c] = ((uint32_t)sbox[s[c] & 0xff] |
+            (uint32_t)sbox[(s[(c + 1) & 3] >> 8) & 0xff] << 8 |
+            (uint32_t)sbox[(s[(c + 2) & 3] >> 16) & 0xff] << 16 |
+            (uint32_t)sbox[s[(c + 3) & 3] >> 24] << 24) ^
+           rk[c];
+  }
+  for (int c = 0; c < 4; c++) {
+    aes_store_word(t[c], &cipher_text[4 * c]);
+  }
+
+  return;
+}
+
+void aes_ctx_decrypt_block(const aes_ctx_t *ctx,
+                           const unsigned char *cipher_text,
+                           unsigned char *plain_text) {
+  const uint32_t *rk = ctx->dec_round_keys;
+  uint32_t s[4], t[4];
+
+  for (int c = 0; c < 4; c++) {
+    s[c] = aes_load_word(&cipher_text[4 * c]) ^ rk[c];
+  }
+
+  // InvSubBytes, InvShiftRows and InvMixColumns: row r of output column c
+  // comes from input column c - r.
+  for (int rnd = 1; rnd < ctx->num_rounds; rnd++) {
+    rk += 4;
+    for (int c = 0; c < 4; c++) {
+      t[c] = td[0][s[c] & 0xff] ^ td[1][(s[(c + 3) & 3] >> 8) & 0xff] ^
+             td[2][(s[(c + 2) & 3] >> 16) & 0xff] ^
+             td[3][s[(c + 1) & 3] >> 24] ^ rk[c];
+    }
+    for (int c = 0; c < 4; c++) {
+      s[c] = t[c];
+    }
+  }
+
+  // final round without InvMixColumns
+  rk += 4;
+  for (int c = 0; c < 4; c++) {
+    t[c] = ((uint32_t)inv_sbox[s[c] & 0xff] |
+            (uint32_t)inv_sbox[(s[(c + 3) & 3] >> 8) & 0xff] << 8 |
+            (uint32_t)inv_sbox[(s[(c + 2) & 3] >> 16) & 0xff] << 16 |
+            (uint32_t)inv_sbox[s[(c + 1) & 3] >> 24] << 24) ^
+           rk[c];
+  }
+  for (int c = 0; c < 4; c++) {
+    aes_store_word(t[c], &plain_text[4 * c]);
+  }
+
+  return;
+}
+
+int aes_crypt(const aes_ctx_t *ctx, crypto_mode_t mode, int op,
+              unsigned char *iv, const unsigned char *input, int len,
+              unsigned char *output) {
+  if (len % 16) {
+    printf("ERROR: len = %i is not a multiple of 16\n", len);
+    return -EINVAL;
+  }
+
+  unsigned char block[16];
+  for (int j = 0; j < len; j += 16) {
+    const unsigned char *in = &input[j];
+    unsigned char *out = &output[j];
+
+    if (mode == kCryptoAesEcb) {
+      if (!op) {
+        aes_ctx_encrypt_block(ctx, in, out);
+      } else {
+        aes_ctx_decrypt_block(ctx, in, out);
+      }
+    } else if (mode == kCryptoAesCbc) {
+      if (!op) {
+        for (int i = 0; i < 16; i++) {
+          block[i] = in[i] ^ iv[i];
+        }
+        aes_ctx_encrypt_block(ctx, block, out);
+        memcpy(iv, out, 16);
+      } else {
+        aes_ctx_decrypt_block(ctx, in, block);
+        for (int i = 0; i < 16; i++) {
+          block[i] ^= iv[i];
+        }
+        memcpy(iv, in, 16);
+        memcpy(out, block, 16);
+      }
+    } else if (mode == kCryptoAesCfb || mode == kCryptoAesOfb ||
+               mode == kCryptoAesCtr) {
+      // these modes only use the forward cipher to generate a key stream
+      aes_ctx_encrypt_block(ctx, iv, block);
+      if (mode == kCryptoAesCfb) {
+        // the next IV is the cipher text
+        for (int i = 0; i < 16; i++) {
+          iv[i] = op ? in[i] : in[i] ^ block[i];
+        }
+      } else if (mode == kCryptoAesOfb) {
+        memcpy(iv, block, 16);
+      } else {
+        for (int i = 15; i >= 0; i--) {
+          if (++iv[i]) {
+            break;
+          }
+        }
+      }
+      for (int i = 0; i < 16; i++) {
+        out[i] = in[i] ^ block[i];
+      }
+    } else {
+      printf("ERROR: mode %i not supported by aes_crypt()\n", mode);
+      return -EINVAL;
+    }
+  }
+
+  return 0;
+}
+
 void aes_add_round_key(unsigned char *state, const unsigned char *round_key) {
   for (int i = 0; i < 16; i++) {
     state[i] ^= round_key[i];
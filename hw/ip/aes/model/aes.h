@@ -5,9 +5,95 @@
 #ifndef OPENTITAN_HW_IP_AES_MODEL_AES_H_
 #define OPENTITAN_HW_IP_AES_MODEL_AES_H_
 
+#include <stdint.h>
+
+#include "crypto.h"
+
+/**
+ * AES context holding the fully expanded encryption and decryption round keys.
+ *
+ * Initialize with aes_ctx_init() once per key and then use it for any number
+ * of blocks with aes_ctx_encrypt_block(), aes_ctx_decrypt_block() or
+ * aes_crypt().
+ */
+typedef struct aes_ctx {
+  /**
+   * Number of cipher rounds (10, 12, 14).
+   */
+  int num_rounds;
+  /**
+   * Encryption round keys, one 32-bit word per key matrix column. Byte 0 of a
+   * column is in the least significant byte of the word.
+   */
+  uint32_t enc_round_keys[4 * 15];
+  /**
+   * Decryption round keys for the Equivalent Inverse Cipher, same layout.
+   */
+  uint32_t dec_round_keys[4 * 15];
+} aes_ctx_t;
+
+/**
+ * Expand a key into an AES context.
+ *
+ * @param  ctx     Context to initialize
+ * @param  key     Initial encryption key
+ * @param  key_len Key length in bytes (16, 24, 32)
+ * @return 0 on success, -ERRNO otherwise
+ */
+int aes_ctx_init(aes_ctx_t *ctx, const unsigned char *key, const int key_len);
+
+/**
+ * Encrypt one data block (16 Bytes) in ECB mode using an expanded key.
+ *
+ * This uses a T-table implementation and is intended for bulk use, e.g., in
+ * scoreboards. The round-by-round functions below model the hardware.
+ *
+ * @param  ctx         Context initialized with aes_ctx_init()
+ * @param  plain_text  Input block to encrypt
+ * @param  cipher_text Encrypted output block, may alias plain_text
+ */
+void aes_ctx_encrypt_block(const aes_ctx_t *ctx,
+                           const unsigned char *plain_text,
+                           unsigned char *cipher_text);
+
+/**
+ * Decrypt one data block (16 Bytes) in ECB mode using an expanded key.
+ *
+ * @param  ctx         Context initialized with aes_ctx_init()
+ * @param  cipher_text Encrypted input block
+ * @param  plain_text  Decrypted output block, may alias cipher_text
+ */
+void aes_ctx_decrypt_block(const aes_ctx_t *ctx,
+                           const unsigned char *cipher_text,
+                           unsigned char *plain_text);
+
+/**
+ * Encrypt or decrypt multiple data blocks using an expanded key.
+ *
+ * The IV is updated in place, so that consecutive calls continue the same
+ * message. CFB is CFB-128, CTR increments the full 128-bit IV as a big-endian
+ * counter.
+ *
+ * @param  ctx    Context initialized with aes_ctx_init()
+ * @param  mode   AES cipher mode @see crypto_mode, kCryptoAesNone is not
+ *                supported
+ * @param  op     0 to encrypt, 1 to decrypt
+ * @param  iv     16-byte initialization vector, ignored for ECB
+ * @param  input  Input data
+ * @param  len    Length of the input data in bytes, must be a multiple of 16
+ * @param  output Output data, may alias input
+ * @return 0 on success, -ERRNO otherwise
+ */
+int aes_crypt(const aes_ctx_t *ctx, crypto_mode_t mode, int op,
+              unsigned char *iv, const unsigned char *input, int len,
+              unsigned char *output);
+
 /**
  * Encrypt one data block (16 Bytes) in ECB mode.
  *
+ * This expands the key for every call. Use an aes_ctx_t when processing
+ * multiple blocks with the same key.
+ *
  * @param  plain_text  Input block to enrypt
  * @param  key         Initial encryption key
  * @param  key_len     Key length in bytes (16, 24, 32)
@@ -20,6 +106,9 @@ int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
 /**
  * Decrypt one data block (16 Bytes) in ECB mode.
  *
+ * This expands the key for every call. Use an aes_ctx_t when processing
+ * multiple blocks with the same key.
+ *
  * @param  plain_text  Encrypted input block
  * @param  key         Initial encryption key
  * @param  key_len     Key length in bytes (16, 24, 32)
@@ -118,6 +118,47 @@ static int crypto_compare(const unsigned char *cipher_text,
   return 0;
 }
 
+static int model_compare(const unsigned char *cipher_text,
+                         const unsigned char *iv,
+                         const unsigned char *plain_text, int len,
+                         const unsigned char *key, int key_len,
+                         crypto_mode_t mode) {
+  aes_ctx_t ctx;
+  unsigned char iv_enc[16];
+  unsigned char iv_dec[16];
+  unsigned char data_out[64];
+  unsigned char data_dec[64];
+
+  if (len > (int)sizeof(data_out) || aes_ctx_init(&ctx, key, key_len)) {
+    printf("ERROR: aes_ctx_init() failed\n");
+    return 1;
+  }
+  memcpy(iv_enc, iv, 16);
+  memcpy(iv_dec, iv, 16);
+
+  // Process the message in two calls to check that chaining carries over.
+  for (int j = 0; j < len; j += len / 2) {
+    if (aes_crypt(&ctx, mode, 0, iv_enc, &plain_text[j], len / 2,
+                  &data_out[j]) ||
+        aes_crypt(&ctx, mode, 1, iv_dec, &data_out[j], len / 2,
+                  &data_dec[j])) {
+      printf("ERROR: aes_crypt() failed\n");
+      return 1;
+    }
+  }
+
+  for (int j = 0; j < len / 16; ++j) {
+    if (check_block(&data_out[j * 16], &cipher_text[j * 16], 1) ||
+        check_block(&data_dec[j * 16], &plain_text[j * 16], 1)) {
+      printf("ERROR: AES model output does not match NIST example\n");
+      return 1;
+    }
+  }
+  printf("SUCCESS: AES model output matches NIST example\n");
+
+  return 0;
+}
+
 int main(int argc, char *argv[]) {
   const int len = 64;
   int key_len;
@@ -154,6 +195,10 @@ int main(int argc, char *argv[]) {
                        mode)) {
       return 1;
     }
+    if (model_compare(cipher_text, iv, kAesModesPlainText, len, key, key_len,
+                      mode)) {
+      return 1;
+    }
   }
 
   /////////
@@ -184,6 +229,10 @@ int main(int argc, char *argv[]) {
                        mode)) {
       return 1;
     }
+    if (model_compare(cipher_text, iv, kAesModesPlainText, len, key, key_len,
+                      mode)) {
+      return 1;
+    }
   }
 
   /////////
@@ -215,6 +264,10 @@ int main(int argc, char *argv[]) {
                        mode)) {
       return 1;
     }
+    if (model_compare(cipher_text, iv, kAesModesPlainText, len, key, key_len,
+                      mode)) {
+      return 1;
+    }
   }
 
   /////////
@@ -245,6 +298,10 @@ int main(int argc, char *argv[]) {
                        mode)) {
       return 1;
     }
+    if (model_compare(cipher_text, iv, kAesModesPlainText, len, key, key_len,
+                      mode)) {
+      return 1;
+    }
   }
 
   /////////
@@ -275,6 +332,10 @@ int main(int argc, char *argv[]) {
                        mode)) {
       return 1;
     }
+    if (model_compare(cipher_text, iv, kAesModesPlainText, len, key, key_len,
+                      mode)) {
+      return 1;
+    }
   }
 
   return 0;
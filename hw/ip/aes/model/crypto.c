@@ -6,6 +6,9 @@
 
 #include <openssl/conf.h>
 #include <openssl/evp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 /**
  * Get EVP_CIPHER type pointer defined by key_len and mode.
@@ -64,101 +67,136 @@ static const EVP_CIPHER *crypto_get_EVP_cipher(int key_len,
   return cipher;
 }
 
-int crypto_encrypt(unsigned char *output, const unsigned char *iv,
-                   const unsigned char *input, int input_len,
-                   const unsigned char *key, int key_len, crypto_mode_t mode) {
-  EVP_CIPHER_CTX *ctx;
-  int ret;
-  int len, output_len;
+struct crypto_ctx {
+  EVP_CIPHER_CTX *evp_ctx;
+  unsigned char key[32];
+  int key_len;
+  crypto_mode_t mode;
+  int op;
+};
+
+crypto_ctx_t *crypto_ctx_new(const unsigned char *key, int key_len,
+                             crypto_mode_t mode, int op) {
+  if (key_len != 16 && key_len != 24 && key_len != 32) {
+    printf("ERROR: key_len = %i not supported\n", key_len);
+    return NULL;
+  }
 
-  // Create new cipher context
-  ctx = EVP_CIPHER_CTX_new();
+  crypto_ctx_t *ctx = (crypto_ctx_t *)malloc(sizeof(crypto_ctx_t));
   if (!ctx) {
+    printf("ERROR: malloc() failed\n");
+    return NULL;
+  }
+
+  // Create new cipher context
+  ctx->evp_ctx = EVP_CIPHER_CTX_new();
+  if (!ctx->evp_ctx) {
     printf("ERROR: Creation of cipher context failed\n");
-    return -1;
+    free(ctx);
+    return NULL;
   }
 
   // Get cipher
   const EVP_CIPHER *cipher = crypto_get_EVP_cipher(key_len, mode);
 
-  // Init encryption context
-  ret = EVP_EncryptInit_ex(ctx, cipher, NULL, key, iv);
-
-  if (ret != 1) {
-    printf("ERROR: Initialization of encryption context failed\n");
-    return -1;
+  // Init context, the key is expanded only once here
+  if (EVP_CipherInit_ex(ctx->evp_ctx, cipher, NULL, key, NULL, !op) != 1) {
+    printf("ERROR: Initialization of cipher context failed\n");
+    crypto_ctx_free(ctx);
+    return NULL;
   }
 
-  // Disable padding - It is safe to do so here because we only ever encrypt
-  // multiples of 16 bytes (the block size).
-  EVP_CIPHER_CTX_set_padding(ctx, 0);
+  memcpy(ctx->key, key, key_len);
+  ctx->key_len = key_len;
+  ctx->mode = mode;
+  ctx->op = op;
 
-  // Provide encryption input, get first output bytes
-  ret = EVP_EncryptUpdate(ctx, output, &output_len, input, input_len);
-  if (ret != 1) {
-    printf("ERROR: Encryption operation failed\n");
+  return ctx;
+}
+
+int crypto_ctx_crypt(crypto_ctx_t *ctx, unsigned char *output,
+                     const unsigned char *iv, const unsigned char *input,
+                     int input_len) {
+  int output_len;
+
+  // Start a new message: only set the IV, keep cipher and key
+  if (iv && EVP_CipherInit_ex(ctx->evp_ctx, NULL, NULL, NULL, iv, -1) != 1) {
+    printf("ERROR: Setting the IV failed\n");
     return -1;
   }
 
-  // Finalize encryption, further bytes might be written
-  ret = EVP_EncryptFinal_ex(ctx, output + output_len, &len);
-  if (ret != 1) {
-    printf("ERROR: Encryption finalizing failed\n");
+  // Disable padding - It is safe to do so here because we only ever process
+  // multiples of 16 bytes (the block size). For the same reason, all output
+  // bytes are available after the update and no finalization is needed.
+  EVP_CIPHER_CTX_set_padding(ctx->evp_ctx, 0);
+
+  if (EVP_CipherUpdate(ctx->evp_ctx, output, &output_len, input, input_len) !=
+      1) {
+    printf("ERROR: %s operation failed\n",
+           ctx->op ? "Decryption" : "Encryption");
     return -1;
   }
-  output_len += len;
-
-  // Free
-  EVP_CIPHER_CTX_free(ctx);
 
   return output_len;
 }
 
-int crypto_decrypt(unsigned char *output, const unsigned char *iv,
-                   const unsigned char *input, int input_len,
-                   const unsigned char *key, int key_len, crypto_mode_t mode) {
-  EVP_CIPHER_CTX *ctx;
-  int ret;
-  int len, output_len;
+void crypto_ctx_free(crypto_ctx_t *ctx) {
+  if (ctx) {
+    EVP_CIPHER_CTX_free(ctx->evp_ctx);
+    free(ctx);
+  }
+}
 
-  // Create new cipher context
-  ctx = EVP_CIPHER_CTX_new();
-  if (!ctx) {
-    printf("ERROR: Creation of cipher context failed\n");
-    return -1;
+/**
+ * Get a cached cipher context for key, key_len and mode.
+ *
+ * @param  cache   Cached context, replaced if it does not match
+ * @param  key     Encryption key
+ * @param  key_len Encryption key length in bytes (16, 24, 32)
+ * @param  mode    AES cipher mode @see crypto_mode.
+ * @param  op      0 to encrypt, 1 to decrypt
+ * @return Pointer to the cached context, NULL in case of error
+ */
+static crypto_ctx_t *crypto_ctx_cached(crypto_ctx_t **cache,
+                                       const unsigned char *key, int key_len,
+                                       crypto_mode_t mode, int op) {
+  crypto_ctx_t *ctx = *cache;
+  if (ctx && ctx->key_len == key_len && ctx->mode == mode &&
+      !memcmp(ctx->key, key, key_len)) {
+    return ctx;
   }
 
-  // Get cipher
-  const EVP_CIPHER *cipher = crypto_get_EVP_cipher(key_len, mode);
+  crypto_ctx_free(ctx);
+  *cache = crypto_ctx_new(key, key_len, mode, op);
+  return *cache;
+}
 
-  // Init decryption context
-  ret = EVP_DecryptInit_ex(ctx, cipher, NULL, key, iv);
-  if (ret != 1) {
-    printf("ERROR: Initialization of decryption context failed\n");
-    return -1;
-  }
+static crypto_ctx_t *encrypt_ctx = NULL;
+static crypto_ctx_t *decrypt_ctx = NULL;
 
-  // Disable padding - It is safe to do so here because we only ever decrypt
-  // multiples of 16 bytes (the block size).
-  EVP_CIPHER_CTX_set_padding(ctx, 0);
+// Used in place of a NULL IV, such that every call starts a new message.
+static const unsigned char zero_iv[16] = {0};
 
-  // Provide decryption input, get first output bytes
-  ret = EVP_DecryptUpdate(ctx, output, &output_len, input, input_len);
-  if (ret != 1) {
-    printf("ERROR: Decryption operation failed\n");
+int crypto_encrypt(unsigned char *output, const unsigned char *iv,
+                   const unsigned char *input, int input_len,
+                   const unsigned char *key, int key_len, crypto_mode_t mode) {
+  crypto_ctx_t *ctx =
+      crypto_ctx_cached(&encrypt_ctx, key, key_len, mode, 0);
+  if (!ctx) {
     return -1;
   }
 
-  // Finalize decryption, further bytes might be written
-  ret = EVP_DecryptFinal_ex(ctx, output + output_len, &len);
-  if (ret != 1) {
-    printf("ERROR: Decryption finalizing failed\n");
+  return crypto_ctx_crypt(ctx, output, iv ? iv : zero_iv, input, input_len);
+}
+
+int crypto_decrypt(unsigned char *output, const unsigned char *iv,
+                   const unsigned char *input, int input_len,
+                   const unsigned char *key, int key_len, crypto_mode_t mode) {
+  crypto_ctx_t *ctx =
+      crypto_ctx_cached(&decrypt_ctx, key, key_len, mode, 1);
+  if (!ctx) {
     return -1;
   }
-  output_len += len;
 
-  // Free
-  EVP_CIPHER_CTX_free(ctx);
-
-  return output_len;
+  return crypto_ctx_crypt(ctx, output, iv ? iv : zero_iv, input, input_len);
 }
@@ -17,9 +17,58 @@ typedef enum crypto_mode {
   kCryptoAesNone = 1 << 5
 } crypto_mode_t;
 
+/**
+ * Persistent BoringSSL/OpenSSL cipher context
+ *
+ * Holds a cipher context with the key already set up, such that many messages
+ * or blocks can be processed without looking up the cipher and expanding the
+ * key every time.
+ */
+typedef struct crypto_ctx crypto_ctx_t;
+
+/**
+ * Create a cipher context
+ *
+ * @param  key     Encryption key, decryption key is derived internally
+ * @param  key_len Encryption key length in bytes (16, 24, 32)
+ * @param  mode    AES cipher mode @see crypto_mode.
+ * @param  op      0 to encrypt, 1 to decrypt
+ * @return Pointer to the new context, NULL in case of error
+ */
+crypto_ctx_t *crypto_ctx_new(const unsigned char *key, int key_len,
+                             crypto_mode_t mode, int op);
+
+/**
+ * Encrypt or decrypt using a cipher context
+ *
+ * If iv is NULL, the operation continues the message of the previous call,
+ * e.g., to feed a message block by block. Otherwise, a new message is started.
+ *
+ * @param  ctx       Context created with crypto_ctx_new()
+ * @param  output    Output data, must be a multiple of 16 bytes
+ * @param  iv        16-byte initialization vector or NULL
+ * @param  input     Input data, must be a multiple of 16 bytes
+ * @param  input_len Length of the input data in bytes, must be a multiple of
+ *                   16
+ * @return Length of the output data in bytes, -1 in case of error
+ */
+int crypto_ctx_crypt(crypto_ctx_t *ctx, unsigned char *output,
+                     const unsigned char *iv, const unsigned char *input,
+                     int input_len);
+
+/**
+ * Free a cipher context
+ *
+ * @param  ctx Context created with crypto_ctx_new(), may be NULL
+ */
+void crypto_ctx_free(crypto_ctx_t *ctx);
+
 /**
  * Encrypt using BoringSSL/OpenSSL
  *
+ * The cipher context of the last call is kept and reused if key, key length
+ * and mode do not change.
+ *
  * @param  output    Output cipher text, must be a multiple of 16 bytes
  * @param  iv        16-byte initialization vector
  * @param  input     Input plain text to encode, must be a multiple of 16 bytes
@@ -37,6 +86,9 @@ int crypto_encrypt(unsigned char *output, const unsigned char *iv,
 /**
  * Decrypt using BoringSSL/OpenSSL
  *
+ * The cipher context of the last call is kept and reused if key, key length
+ * and mode do not change.
+ *
  * @param  output    Output plain text, must be a multiple of 16 bytes
  * @param  iv        16-byte initialization vector
  * @param  input     Input cipher text to decode, must be a multiple of 16 bytes
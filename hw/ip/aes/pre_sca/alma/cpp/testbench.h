@@ -6,35 +6,112 @@
 #ifndef OPENTITAN_HW_IP_AES_PRE_SCA_ALMA_CPP_TESTBENCH_H_
 #define OPENTITAN_HW_IP_AES_PRE_SCA_ALMA_CPP_TESTBENCH_H_
 
+#include <limits.h>
+#include <random>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "verilated.h"
+
+// Models verilated with `--trace-fst` write FST, which is much smaller than
+// VCD for long traces. Alma itself only reads VCD.
+#if VM_TRACE_FST
+#include "verilated_fst_c.h"
+typedef VerilatedFstC TestbenchTrace;
+#define TESTBENCH_TRACE_EXT "fst"
+#else
 #include "verilated_vcd_c.h"
+typedef VerilatedVcdC TestbenchTrace;
+#define TESTBENCH_TRACE_EXT "vcd"
+#endif
 
+/**
+ * Testbench wrapper around a verilated module.
+ *
+ * The following plusargs are supported:
+ *   +vectors=N      Number of stimulus vectors to run (default 1). With more
+ *                   than one vector, vector i is traced to tmp_<i>.vcd instead
+ *                   of tmp.vcd.
+ *   +seed=S         Seed for the random masks and PRD of vectors 1 and up.
+ *   +trace_levels=L Hierarchy depth to trace (default 99, i.e. everything).
+ *   +trace_start=T  First tick of each vector to dump (default 0).
+ *   +trace_end=T    Tick of each vector at which dumping stops (default: end
+ *                   of the vector).
+ */
 template <class Module>
 struct Testbench {
   unsigned long m_tickcount;
   Module m_core;
-  VerilatedVcdC *m_trace = NULL;
+  TestbenchTrace *m_trace = NULL;
+
+  unsigned long m_num_vectors;
+  int m_trace_levels;
+  unsigned long m_trace_start;
+  unsigned long m_trace_end;
+  std::mt19937 m_rng;
 
   Testbench() {
     Verilated::traceEverOn(true);
     m_tickcount = 0ul;
+    m_num_vectors = plusarg("vectors", 1);
+    m_trace_levels = (int)plusarg("trace_levels", 99);
+    m_trace_start = plusarg("trace_start", 0);
+    m_trace_end = plusarg("trace_end", ULONG_MAX);
+    m_rng.seed((uint32_t)plusarg("seed", 0));
+  }
+
+  ~Testbench() {
+    closetrace();
+    delete m_trace;
+  }
+
+  /**
+   * Returns the value of `+<name>=<value>`, or `dflt` if it was not given.
+   */
+  static unsigned long plusarg(const char *name, unsigned long dflt) {
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), "+%s=", name);
+    const char *match = Verilated::commandArgsPlusMatch(prefix);
+    if (!match || !*match) {
+      return dflt;
+    }
+    return strtoul(match + strlen(prefix), NULL, 0);
   }
 
-  ~Testbench() { closetrace(); }
+  uint32_t random32() { return m_rng(); }
 
   void opentrace(const char *vcdname) {
     if (!m_trace) {
-      m_trace = new VerilatedVcdC;
-      m_core.trace(m_trace, 99);
+      m_trace = new TestbenchTrace;
+      m_core.trace(m_trace, m_trace_levels);
+    }
+    if (!m_trace->isOpen()) {
       m_trace->open(vcdname);
     }
   }
 
+  /**
+   * Opens the trace segment of stimulus vector `vector`.
+   *
+   * Each segment starts at time 0 so that it can be verified on its own.
+   */
+  void opentrace(unsigned long vector) {
+    char name[32];
+    if (m_num_vectors == 1) {
+      snprintf(name, sizeof(name), "tmp." TESTBENCH_TRACE_EXT);
+    } else {
+      snprintf(name, sizeof(name), "tmp_%lu." TESTBENCH_TRACE_EXT, vector);
+    }
+    closetrace();
+    m_tickcount = 0ul;
+    opentrace(name);
+  }
+
   void closetrace() {
-    if (m_trace) {
+    if (m_trace && m_trace->isOpen()) {
       m_trace->close();
-      delete m_trace;
-      m_trace = NULL;
     }
   }
 
@@ -46,24 +123,27 @@ struct Testbench {
   }
 
   void tick() {
+    bool dump = m_trace && m_tickcount >= m_trace_start &&
+                m_tickcount < m_trace_end;
+
     // Falling edge
     m_core.clk_i = 0;
     m_core.eval();
-    if (m_trace)
+    if (dump)
       m_trace->dump(20 * m_tickcount);
 
     // Rising edge
     m_core.clk_i = 1;
     m_core.eval();
-    if (m_trace)
+    if (dump)
       m_trace->dump(20 * m_tickcount + 10);
 
     // Falling edge settle eval
     m_core.clk_i = 0;
     m_core.eval();
 
-    if (m_trace)
-      m_trace->flush();
+    // The trace is flushed when it is closed. Flushing on every tick makes
+    // long traces I/O bound.
     m_tickcount++;
   }
 
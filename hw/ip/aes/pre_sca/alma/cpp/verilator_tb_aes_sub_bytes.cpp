@@ -11,31 +11,41 @@
 int main(int argc, char **argv) {
   Verilated::commandArgs(argc, argv);
   Testbench<Vcircuit> tb;
-  tb.opentrace("tmp.vcd");
 
-  tb.reset();
-
-  // Data signals - we don't really care about the data fed to the module.
-  // The whole tracing is really just about control signals.
-  for (int i = 0; i < 4; ++i) {
-    tb.m_core.data_i[i] = i;
-    tb.m_core.mask_i[i] = 4 + i;
-    tb.m_core.prd_i[i] = 8 + i;
-  }
-
-  // Control signals
-  tb.m_core.out_ack_i = 3;  // SP2V_HIGH, always ack
-  tb.m_core.op_i = 0;       // encrypt
-
-  tb.m_core.en_i = 4;  // SP2V_LOW, disable
-  tb.tick();
-  tb.m_core.en_i = 3;  // SP2V_HIGH, enable
-  tb.tick();
+  for (unsigned long vector = 0; vector < tb.m_num_vectors; ++vector) {
+    tb.opentrace(vector);
+
+    tb.reset();
+
+    // Data signals - we don't really care about the data fed to the module.
+    // The whole tracing is really just about control signals. Vectors after
+    // the first one use random data, masks and PRD.
+    for (int i = 0; i < 4; ++i) {
+      if (vector == 0) {
+        tb.m_core.data_i[i] = i;
+        tb.m_core.mask_i[i] = 4 + i;
+        tb.m_core.prd_i[i] = 8 + i;
+      } else {
+        tb.m_core.data_i[i] = tb.random32();
+        tb.m_core.mask_i[i] = tb.random32();
+        tb.m_core.prd_i[i] = tb.random32();
+      }
+    }
+
+    // Control signals
+    tb.m_core.out_ack_i = 3;  // SP2V_HIGH, always ack
+    tb.m_core.op_i = 0;       // encrypt
+
+    tb.m_core.en_i = 4;  // SP2V_LOW, disable
+    tb.tick();
+    tb.m_core.en_i = 3;  // SP2V_HIGH, enable
+    tb.tick();
 
-  while (tb.m_core.out_req_o != 3) {
+    while (tb.m_core.out_req_o != 3) {
+      tb.tick();
+    }
     tb.tick();
-  }
-  tb.tick();
 
-  tb.closetrace();
+    tb.closetrace();
+  }
 }
@@ -11,53 +11,65 @@
 int main(int argc, char **argv) {
   Verilated::commandArgs(argc, argv);
   Testbench<Vcircuit> tb;
-  tb.opentrace("tmp.vcd");
-
-  tb.reset();
-
-  // Data signals - we don't really care about the data fed to the module.
-  // The whole tracing is really just about control signals.
-  tb.m_core.rand_i = 0x0123456789ABCDEF;
-  tb.m_core.rand_aux_i = 0x0;
-  // With WIDTH = 50, we should drive 100 = 3 * 32 + 4 bits. Driving more bits
-  // sometimes leads to encoding issues in the VCD.
-  tb.m_core.s_i[0] = 0x01234567;
-  tb.m_core.s_i[1] = 0x89ABCDEF;
-  tb.m_core.s_i[2] = 0x01234567;
-  tb.m_core.s_i[3] = 0xF;
-
-  // Control signals
-  tb.m_core.rnd_i = 0;  // Round, just defines which round constant is added
-                        // at the very end.
-
-  // Phase 1 - Theta, Rho, Pi - Takes 1 cycle.
-  tb.m_core.phase_sel_i = 0x5;
-  tb.m_core.cycle_i = 0x0;
-  tb.tick();
-  // Phase 2 - Chi, Iota - Takes 3 cycles.
-  tb.m_core.phase_sel_i = 0xA;
-  tb.m_core.cycle_i = 0x1;
-  tb.tick();
-  tb.m_core.phase_sel_i = 0xA;
-  tb.m_core.cycle_i = 0x2;
-  tb.tick();
-  tb.m_core.phase_sel_i = 0xA;
-  tb.m_core.cycle_i = 0x3;
-  tb.tick();
-  // Phase 1 again - Theta, Rho, Pi - Takes 1 cycle.
-  tb.m_core.phase_sel_i = 0x5;
-  tb.m_core.cycle_i = 0x0;
-  tb.tick();
-  // Phase 2 - Chi, Iota - Takes 3 cycles.
-  tb.m_core.phase_sel_i = 0xA;
-  tb.m_core.cycle_i = 0x1;
-  tb.tick();
-  tb.m_core.phase_sel_i = 0xA;
-  tb.m_core.cycle_i = 0x2;
-  tb.tick();
-  tb.m_core.phase_sel_i = 0xA;
-  tb.m_core.cycle_i = 0x3;
-  tb.tick();
-
-  tb.closetrace();
+
+  for (unsigned long vector = 0; vector < tb.m_num_vectors; ++vector) {
+    tb.opentrace(vector);
+
+    tb.reset();
+
+    // Data signals - we don't really care about the data fed to the module.
+    // The whole tracing is really just about control signals. Vectors after
+    // the first one use random state shares and randomness.
+    // With WIDTH = 50, we should drive 100 = 3 * 32 + 4 bits. Driving more
+    // bits sometimes leads to encoding issues in the VCD.
+    tb.m_core.rand_aux_i = 0x0;
+    if (vector == 0) {
+      tb.m_core.rand_i = 0x0123456789ABCDEF;
+      tb.m_core.s_i[0] = 0x01234567;
+      tb.m_core.s_i[1] = 0x89ABCDEF;
+      tb.m_core.s_i[2] = 0x01234567;
+      tb.m_core.s_i[3] = 0xF;
+    } else {
+      tb.m_core.rand_i = tb.random32() & 0x1FFFFFF;
+      tb.m_core.s_i[0] = tb.random32();
+      tb.m_core.s_i[1] = tb.random32();
+      tb.m_core.s_i[2] = tb.random32();
+      tb.m_core.s_i[3] = tb.random32() & 0xF;
+    }
+
+    // Control signals
+    tb.m_core.rnd_i = 0;  // Round, just defines which round constant is added
+                          // at the very end.
+
+    // Phase 1 - Theta, Rho, Pi - Takes 1 cycle.
+    tb.m_core.phase_sel_i = 0x5;
+    tb.m_core.cycle_i = 0x0;
+    tb.tick();
+    // Phase 2 - Chi, Iota - Takes 3 cycles.
+    tb.m_core.phase_sel_i = 0xA;
+    tb.m_core.cycle_i = 0x1;
+    tb.tick();
+    tb.m_core.phase_sel_i = 0xA;
+    tb.m_core.cycle_i = 0x2;
+    tb.tick();
+    tb.m_core.phase_sel_i = 0xA;
+    tb.m_core.cycle_i = 0x3;
+    tb.tick();
+    // Phase 1 again - Theta, Rho, Pi - Takes 1 cycle.
+    tb.m_core.phase_sel_i = 0x5;
+    tb.m_core.cycle_i = 0x0;
+    tb.tick();
+    // Phase 2 - Chi, Iota - Takes 3 cycles.
+    tb.m_core.phase_sel_i = 0xA;
+    tb.m_core.cycle_i = 0x1;
+    tb.tick();
+    tb.m_core.phase_sel_i = 0xA;
+    tb.m_core.cycle_i = 0x2;
+    tb.tick();
+    tb.m_core.phase_sel_i = 0xA;
+    tb.m_core.cycle_i = 0x3;
+    tb.tick();
+
+    tb.closetrace();
+  }
 }
@@ -12,8 +12,14 @@
 // that are shared between them are commented only in `memcpy()`.
 void hardened_memcpy(uint32_t *restrict dest, const uint32_t *restrict src,
                      size_t word_len) {
+  hardened_memcpy_decoys(dest, src, word_len, kRandomOrderDefaultDecoyPercent);
+}
+
+void hardened_memcpy_decoys(uint32_t *restrict dest,
+                            const uint32_t *restrict src, size_t word_len,
+                            size_t decoy_percent) {
   random_order_t order;
-  random_order_init(&order, word_len);
+  random_order_init_decoys(&order, word_len, decoy_percent);
 
   size_t count = 0;
   size_t expected_count = random_order_len(&order);
@@ -78,13 +84,63 @@ void hardened_memcpy(uint32_t *restrict dest, const uint32_t *restrict src,
   HARDENED_CHECK_EQ(count, expected_count);
 }
 
+void hardened_memcpy_blocks(uint32_t *restrict dest,
+                            const uint32_t *restrict src, size_t word_len) {
+  enum { kBlockWords = 4 };
+  size_t block_len = word_len / kBlockWords;
+
+  // No decoys: the data is not secret, only the order of the accesses is
+  // randomized.
+  random_order_t order;
+  random_order_init_decoys(&order, block_len, 0);
+
+  size_t count = 0;
+  size_t expected_count = random_order_len(&order);
+
+  uintptr_t src_addr = (uintptr_t)src;
+  uintptr_t dest_addr = (uintptr_t)dest;
+
+  for (; launderw(count) < expected_count; count = launderw(count) + 1) {
+    size_t byte_idx = launderw(random_order_advance(&order)) * kBlockWords *
+                      sizeof(uint32_t);
+    barrierw(byte_idx);
+
+    const void *srcp = (const void *)(src_addr + byte_idx);
+    void *destp = (void *)(dest_addr + byte_idx);
+
+    // Load the whole block before storing it, so that the loads and stores
+    // can issue back-to-back.
+    uint32_t w0 = read_32((const char *)srcp + 0 * sizeof(uint32_t));
+    uint32_t w1 = read_32((const char *)srcp + 1 * sizeof(uint32_t));
+    uint32_t w2 = read_32((const char *)srcp + 2 * sizeof(uint32_t));
+    uint32_t w3 = read_32((const char *)srcp + 3 * sizeof(uint32_t));
+    write_32(w0, (char *)destp + 0 * sizeof(uint32_t));
+    write_32(w1, (char *)destp + 1 * sizeof(uint32_t));
+    write_32(w2, (char *)destp + 2 * sizeof(uint32_t));
+    write_32(w3, (char *)destp + 3 * sizeof(uint32_t));
+  }
+  HARDENED_CHECK_EQ(count, expected_count);
+
+  // Copy the remaining words, if any, in order.
+  size_t i = block_len * kBlockWords;
+  for (; launderw(i) < word_len; i = launderw(i) + 1) {
+    write_32(read_32(&src[i]), &dest[i]);
+  }
+  HARDENED_CHECK_EQ(i, word_len);
+}
+
 // The source of randomness for shred, which may be replaced at link-time.
 OT_WEAK
 uint32_t hardened_memshred_random_word(void) { return 0xcaffe17e; }
 
 void hardened_memshred(uint32_t *dest, size_t word_len) {
+  hardened_memshred_decoys(dest, word_len, kRandomOrderDefaultDecoyPercent);
+}
+
+void hardened_memshred_decoys(uint32_t *dest, size_t word_len,
+                              size_t decoy_percent) {
   random_order_t order;
-  random_order_init(&order, word_len);
+  random_order_init_decoys(&order, word_len, decoy_percent);
 
   size_t count = 0;
   size_t expected_count = random_order_len(&order);
@@ -114,8 +170,14 @@ void hardened_memshred(uint32_t *dest, size_t word_len) {
 
 hardened_bool_t hardened_memeq(const uint32_t *lhs, const uint32_t *rhs,
                                size_t word_len) {
+  return hardened_memeq_decoys(lhs, rhs, word_len,
+                               kRandomOrderDefaultDecoyPercent);
+}
+
+hardened_bool_t hardened_memeq_decoys(const uint32_t *lhs, const uint32_t *rhs,
+                                      size_t word_len, size_t decoy_percent) {
   random_order_t order;
-  random_order_init(&order, word_len);
+  random_order_init_decoys(&order, word_len, decoy_percent);
 
   size_t count = 0;
   size_t expected_count = random_order_len(&order);
@@ -15,6 +15,7 @@
 
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/random_order.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +41,43 @@ extern "C" {
 void hardened_memcpy(uint32_t *OT_RESTRICT dest,
                      const uint32_t *OT_RESTRICT src, size_t word_len);
 
+/**
+ * Copies 32-bit words between non-overlapping regions, with a given number of
+ * decoy operations.
+ *
+ * Same as `hardened_memcpy()`, which uses
+ * `kRandomOrderDefaultDecoyPercent`, but lets the caller trade hardening for
+ * speed: the number of iterations is
+ * `word_len + word_len * decoy_percent / 100`.
+ *
+ * @param dest The destination of the copy.
+ * @param src The source of the copy.
+ * @param word_len The number of words to copy.
+ * @param decoy_percent The number of decoy copies, in percent of `word_len`.
+ */
+void hardened_memcpy_decoys(uint32_t *OT_RESTRICT dest,
+                            const uint32_t *OT_RESTRICT src, size_t word_len,
+                            size_t decoy_percent);
+
+/**
+ * Copies 32-bit words between non-overlapping regions, in blocks of four
+ * words in a random block order.
+ *
+ * This is much faster than `hardened_memcpy()` since it does no decoy copies
+ * and each iteration copies a whole block, but it does not hide the data
+ * itself. It must only be used for data that is not secret, where only the
+ * access order and loop completion need to be hardened. Trailing words that do
+ * not fill a block are copied in order.
+ *
+ * Input pointers *MUST* be 32-bit aligned.
+ *
+ * @param dest The destination of the copy.
+ * @param src The source of the copy.
+ * @param word_len The number of words to copy.
+ */
+void hardened_memcpy_blocks(uint32_t *OT_RESTRICT dest,
+                            const uint32_t *OT_RESTRICT src, size_t word_len);
+
 /**
  * Fills a 32-bit aligned region of memory with random data.
  *
@@ -59,6 +97,20 @@ void hardened_memcpy(uint32_t *OT_RESTRICT dest,
  */
 void hardened_memshred(uint32_t *dest, size_t word_len);
 
+/**
+ * Fills a 32-bit aligned region of memory with random data, with a given
+ * number of decoy operations.
+ *
+ * Same as `hardened_memshred()`, which uses
+ * `kRandomOrderDefaultDecoyPercent`.
+ *
+ * @param dest The destination of the set.
+ * @param word_len The number of words to write.
+ * @param decoy_percent The number of decoy writes, in percent of `word_len`.
+ */
+void hardened_memshred_decoys(uint32_t *dest, size_t word_len,
+                              size_t decoy_percent);
+
 /**
  * Compare two potentially-overlapping 32-bit aligned regions of memory for
  * equality.
@@ -83,6 +135,22 @@ void hardened_memshred(uint32_t *dest, size_t word_len);
 hardened_bool_t hardened_memeq(const uint32_t *lhs, const uint32_t *rhs,
                                size_t word_len);
 
+/**
+ * Compare two potentially-overlapping 32-bit aligned regions of memory for
+ * equality, with a given number of decoy operations.
+ *
+ * Same as `hardened_memeq()`, which uses `kRandomOrderDefaultDecoyPercent`.
+ *
+ * @param lhs The first buffer to compare.
+ * @param rhs The second buffer to compare.
+ * @param word_len The number of words to compare.
+ * @param decoy_percent The number of decoy comparisons, in percent of
+ * `word_len`.
+ * @return `kHardenedBoolTrue` if the regions are equal.
+ */
+hardened_bool_t hardened_memeq_decoys(const uint32_t *lhs, const uint32_t *rhs,
+                                      size_t word_len, size_t decoy_percent);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
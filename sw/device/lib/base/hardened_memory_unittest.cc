@@ -29,6 +29,31 @@ TEST(HardenedMemory, Memcpy) {
   EXPECT_THAT(ys, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7));
 }
 
+TEST(HardenedMemory, MemcpyDecoys) {
+  std::vector<uint32_t> xs = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  for (size_t decoy_percent : {0, 25, 50, 100, 200}) {
+    std::vector<uint32_t> ys(8);
+    hardened_memcpy_decoys(ys.data(), xs.data(), xs.size(), decoy_percent);
+    EXPECT_EQ(ys, xs);
+  }
+}
+
+TEST(HardenedMemory, MemcpyBlocks) {
+  std::vector<uint32_t> xs(19);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    xs[i] = i + 1;
+  }
+
+  for (size_t len = 0; len <= xs.size(); ++len) {
+    std::vector<uint32_t> ys(xs.size());
+    hardened_memcpy_blocks(ys.data(), xs.data(), len);
+    for (size_t i = 0; i < ys.size(); ++i) {
+      EXPECT_EQ(ys[i], i < len ? xs[i] : 0) << "len = " << len;
+    }
+  }
+}
+
 constexpr uint32_t kRandomWord = 0xdeadbeef;
 
 // Override whatever the default randomness source is so we can verify it
@@ -40,6 +65,10 @@ TEST(HardenedMemory, MemShred) {
   hardened_memshred(xs.data(), xs.size());
 
   EXPECT_THAT(xs, Each(kRandomWord));
+
+  std::vector<uint32_t> ys = {1, 2, 3, 4, 5};
+  hardened_memshred_decoys(ys.data(), ys.size(), 0);
+  EXPECT_THAT(ys, Each(kRandomWord));
 }
 
 TEST(HardenedMemory, MemEq) {
@@ -53,5 +82,19 @@ TEST(HardenedMemory, MemEq) {
             kHardenedBoolFalse);
 }
 
+TEST(HardenedMemory, MemEqDecoys) {
+  std::vector<uint32_t> xs = {1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<uint32_t> ys = xs;
+
+  EXPECT_EQ(hardened_memeq_decoys(ys.data(), xs.data(), xs.size(), 0),
+            kHardenedBoolTrue);
+
+  ++ys[7];
+  EXPECT_EQ(hardened_memeq_decoys(ys.data(), xs.data(), xs.size(), 0),
+            kHardenedBoolFalse);
+  EXPECT_EQ(hardened_memeq_decoys(ys.data(), xs.data(), xs.size(), 50),
+            kHardenedBoolFalse);
+}
+
 }  // namespace
 }  // namespace hardened_memory_unittest
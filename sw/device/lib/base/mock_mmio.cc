@@ -17,35 +17,35 @@ mmio_region_t mmio_region_from_addr(uintptr_t address) {
 }
 
 uint8_t mmio_region_read8(mmio_region_t base, ptrdiff_t offset) {
-  auto *dev = static_cast<MockDevice *>(base.mock);
+  auto *dev = static_cast<Device *>(base.mock);
   return dev->Read8(offset);
 }
 
 uint32_t mmio_region_read32(mmio_region_t base, ptrdiff_t offset) {
-  auto *dev = static_cast<MockDevice *>(base.mock);
+  auto *dev = static_cast<Device *>(base.mock);
   return dev->Read32(offset);
 }
 
 void mmio_region_write8(mmio_region_t base, ptrdiff_t offset, uint8_t value) {
-  auto *dev = static_cast<MockDevice *>(base.mock);
+  auto *dev = static_cast<Device *>(base.mock);
   dev->Write8(offset, value);
 }
 
 void mmio_region_write8_shadowed(mmio_region_t base, ptrdiff_t offset,
                                  uint8_t value) {
-  auto *dev = static_cast<MockDevice *>(base.mock);
+  auto *dev = static_cast<Device *>(base.mock);
   dev->Write8(offset, value);
   dev->Write8(offset, value);
 }
 
 void mmio_region_write32(mmio_region_t base, ptrdiff_t offset, uint32_t value) {
-  auto *dev = static_cast<MockDevice *>(base.mock);
+  auto *dev = static_cast<Device *>(base.mock);
   dev->Write32(offset, value);
 }
 
 void mmio_region_write32_shadowed(mmio_region_t base, ptrdiff_t offset,
                                   uint32_t value) {
-  auto *dev = static_cast<MockDevice *>(base.mock);
+  auto *dev = static_cast<Device *>(base.mock);
   dev->Write32(offset, value);
   dev->Write32(offset, value);
 }
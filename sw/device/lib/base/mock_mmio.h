@@ -29,6 +29,26 @@ namespace mock_mmio {
  */
 inline mock_mmio::LittleEndianBytes LeInt(const char *bytes) { return {bytes}; }
 
+/**
+ * A Device is anything that can stand in for an MMIO device in tests.
+ *
+ * The `mmio.h` functions compiled with `-DMOCK_MMIO` forward every access made
+ * through a `mmio_region_t` to the `Device` it was created from.
+ * Implementations are either the strict, expectation-based `MockDevice` below,
+ * or a behavioural model such as `RegisterFileDevice` (see
+ * `mock_mmio_regfile.h`).
+ */
+class Device {
+ public:
+  virtual ~Device() = default;
+
+  virtual uint8_t Read8(ptrdiff_t offset) = 0;
+  virtual uint32_t Read32(ptrdiff_t offset) = 0;
+
+  virtual void Write8(ptrdiff_t offset, uint8_t value) = 0;
+  virtual void Write32(ptrdiff_t offset, uint32_t value) = 0;
+};
+
 /**
  * A MockDevice represents a mock implementation of an MMIO device.
  *
@@ -45,7 +65,7 @@ inline mock_mmio::LittleEndianBytes LeInt(const char *bytes) { return {bytes}; }
  * To use this class, `-DMOCK_MMIO` must be enabled in all translation units
  * using `mmio.h`.
  */
-class MockDevice {
+class MockDevice : public Device {
  public:
   MockDevice() = default;
 
@@ -58,13 +78,13 @@ class MockDevice {
    * Converts this MockDevice into a mmio_region_t opaque object,
    * which is compatible with `mmio.h` functions.
    */
-  mmio_region_t region() { return {this}; }
+  mmio_region_t region() { return {static_cast<Device *>(this)}; }
 
-  MOCK_METHOD(uint8_t, Read8, (ptrdiff_t offset));
-  MOCK_METHOD(uint32_t, Read32, (ptrdiff_t offset));
+  MOCK_METHOD(uint8_t, Read8, (ptrdiff_t offset), (override));
+  MOCK_METHOD(uint32_t, Read32, (ptrdiff_t offset), (override));
 
-  MOCK_METHOD(void, Write8, (ptrdiff_t offset, uint8_t value));
-  MOCK_METHOD(void, Write32, (ptrdiff_t offset, uint32_t value));
+  MOCK_METHOD(void, Write8, (ptrdiff_t offset, uint8_t value), (override));
+  MOCK_METHOD(void, Write32, (ptrdiff_t offset, uint32_t value), (override));
 
   /**
    * Generates "garbage memory" for use in tests. This function should not
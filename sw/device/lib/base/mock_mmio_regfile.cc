@@ -0,0 +1,154 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/mock_mmio_regfile.h"
+
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace mock_mmio {
+void RegisterFileDevice::Declare(ptrdiff_t offset, Model model,
+                                 uint32_t reset) {
+  Register &reg = regs_[offset];
+  reg.model = model;
+  reg.value = reset;
+  reg.fifo.clear();
+  reg.reads = 0;
+  reg.writes = 0;
+}
+
+RegisterFileDevice::Register *RegisterFileDevice::Find(ptrdiff_t offset) {
+  auto it = regs_.find(offset);
+  if (it == regs_.end()) {
+    ADD_FAILURE() << "access to undeclared register at offset 0x" << std::hex
+                  << offset;
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void RegisterFileDevice::Rw(ptrdiff_t offset, uint32_t reset) {
+  Declare(offset, Model::kRw, reset);
+}
+
+void RegisterFileDevice::Ro(ptrdiff_t offset, uint32_t reset) {
+  Declare(offset, Model::kRo, reset);
+}
+
+void RegisterFileDevice::W1c(ptrdiff_t offset, uint32_t reset) {
+  Declare(offset, Model::kW1c, reset);
+}
+
+void RegisterFileDevice::Fifo(ptrdiff_t offset) {
+  Declare(offset, Model::kFifo, 0);
+}
+
+void RegisterFileDevice::OnRead(ptrdiff_t offset, ReadCallback callback) {
+  if (Register *reg = Find(offset)) {
+    reg->on_read = std::move(callback);
+  }
+}
+
+void RegisterFileDevice::OnWrite(ptrdiff_t offset, WriteCallback callback) {
+  if (Register *reg = Find(offset)) {
+    reg->on_write = std::move(callback);
+  }
+}
+
+uint32_t RegisterFileDevice::Get(ptrdiff_t offset) {
+  Register *reg = Find(offset);
+  return reg != nullptr ? reg->value : 0;
+}
+
+void RegisterFileDevice::Set(ptrdiff_t offset, uint32_t value) {
+  if (Register *reg = Find(offset)) {
+    reg->value = value;
+  }
+}
+
+std::deque<uint32_t> &RegisterFileDevice::FifoData(ptrdiff_t offset) {
+  Register &reg = regs_.at(offset);
+  EXPECT_TRUE(reg.model == Model::kFifo)
+      << "register at offset 0x" << std::hex << offset << " is not a FIFO";
+  return reg.fifo;
+}
+
+size_t RegisterFileDevice::Reads(ptrdiff_t offset) {
+  Register *reg = Find(offset);
+  return reg != nullptr ? reg->reads : 0;
+}
+
+size_t RegisterFileDevice::Writes(ptrdiff_t offset) {
+  Register *reg = Find(offset);
+  return reg != nullptr ? reg->writes : 0;
+}
+
+void RegisterFileDevice::ClearCounts() {
+  for (auto &entry : regs_) {
+    entry.second.reads = 0;
+    entry.second.writes = 0;
+  }
+  reads_ = 0;
+  writes_ = 0;
+}
+
+uint8_t RegisterFileDevice::Read8(ptrdiff_t offset) {
+  return static_cast<uint8_t>(Read32(offset));
+}
+
+uint32_t RegisterFileDevice::Read32(ptrdiff_t offset) {
+  Register *reg = Find(offset);
+  if (reg == nullptr) {
+    return 0;
+  }
+  ++reg->reads;
+  ++reads_;
+  if (reg->on_read) {
+    reg->on_read();
+  }
+
+  if (reg->model != Model::kFifo) {
+    return reg->value;
+  }
+  if (reg->fifo.empty()) {
+    ADD_FAILURE() << "read from empty FIFO at offset 0x" << std::hex << offset;
+    return 0;
+  }
+  uint32_t value = reg->fifo.front();
+  reg->fifo.pop_front();
+  return value;
+}
+
+void RegisterFileDevice::Write8(ptrdiff_t offset, uint8_t value) {
+  Write32(offset, value);
+}
+
+void RegisterFileDevice::Write32(ptrdiff_t offset, uint32_t value) {
+  Register *reg = Find(offset);
+  if (reg == nullptr) {
+    return;
+  }
+  ++reg->writes;
+  ++writes_;
+
+  switch (reg->model) {
+    case Model::kRw:
+      reg->value = value;
+      break;
+    case Model::kRo:
+      break;
+    case Model::kW1c:
+      reg->value &= ~value;
+      break;
+    case Model::kFifo:
+      reg->fifo.push_back(value);
+      break;
+  }
+
+  if (reg->on_write) {
+    reg->on_write(value);
+  }
+}
+}  // namespace mock_mmio
@@ -0,0 +1,175 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_BASE_MOCK_MMIO_REGFILE_H_
+#define OPENTITAN_SW_DEVICE_LIB_BASE_MOCK_MMIO_REGFILE_H_
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/base/mock_mmio.h"
+
+namespace mock_mmio {
+/**
+ * A RegisterFileDevice is a behavioural model of an MMIO device.
+ *
+ * Where `MockDevice` checks a strict sequence of expected accesses, a
+ * RegisterFileDevice holds register state and answers whatever accesses the
+ * code under test makes. This makes it practical to test code that makes a
+ * data-dependent number of accesses, such as burst FIFO transfers, and to
+ * check the number of accesses made.
+ *
+ * Each register used by a test must be declared with one of the models below;
+ * accessing an undeclared register is a test failure. Side effects, such as a
+ * status register tracking a FIFO level, are modelled with `OnRead()` and
+ * `OnWrite()` callbacks.
+ *
+ * 8-bit accesses behave like 32-bit accesses to the same register, with the
+ * value zero-extended on writes and truncated on reads. In particular, each
+ * 8-bit write to a FIFO pushes one entry.
+ *
+ * To use this class, `-DMOCK_MMIO` must be enabled in all translation units
+ * using `mmio.h`.
+ */
+class RegisterFileDevice : public Device {
+ public:
+  /**
+   * Called before a register is read.
+   */
+  using ReadCallback = std::function<void()>;
+  /**
+   * Called after a register is written, with the value written.
+   */
+  using WriteCallback = std::function<void(uint32_t value)>;
+
+  RegisterFileDevice() = default;
+
+  RegisterFileDevice(const RegisterFileDevice &) = delete;
+  RegisterFileDevice &operator=(const RegisterFileDevice &) = delete;
+  RegisterFileDevice(RegisterFileDevice &&) = delete;
+  RegisterFileDevice &operator=(RegisterFileDevice &&) = delete;
+
+  /**
+   * Converts this device into a mmio_region_t opaque object, which is
+   * compatible with `mmio.h` functions.
+   */
+  mmio_region_t region() { return {static_cast<Device *>(this)}; }
+
+  /**
+   * Declares a read-write register: reads return the last value written.
+   */
+  void Rw(ptrdiff_t offset, uint32_t reset = 0);
+  /**
+   * Declares a read-only register: writes are ignored, and only the test
+   * changes its value, with `Set()`.
+   */
+  void Ro(ptrdiff_t offset, uint32_t reset = 0);
+  /**
+   * Declares a write-one-to-clear register: writing a value clears the bits
+   * that are set in it.
+   */
+  void W1c(ptrdiff_t offset, uint32_t reset = 0);
+  /**
+   * Declares a FIFO-backed data port: writes push to the back of the FIFO and
+   * reads pop from the front. Reading an empty FIFO is a test failure.
+   */
+  void Fifo(ptrdiff_t offset);
+
+  /**
+   * Registers a callback to run before each read of the register at `offset`.
+   */
+  void OnRead(ptrdiff_t offset, ReadCallback callback);
+  /**
+   * Registers a callback to run after each write to the register at `offset`.
+   */
+  void OnWrite(ptrdiff_t offset, WriteCallback callback);
+
+  /**
+   * Returns the current value of a register, without counting an access.
+   */
+  uint32_t Get(ptrdiff_t offset);
+  /**
+   * Sets the value of a register, bypassing its model.
+   */
+  void Set(ptrdiff_t offset, uint32_t value);
+  /**
+   * Returns the entries of a FIFO-backed data port, for the test to fill or
+   * inspect.
+   */
+  std::deque<uint32_t> &FifoData(ptrdiff_t offset);
+
+  /**
+   * Returns the number of reads of the register at `offset`.
+   */
+  size_t Reads(ptrdiff_t offset);
+  /**
+   * Returns the number of writes to the register at `offset`.
+   */
+  size_t Writes(ptrdiff_t offset);
+  /**
+   * Returns the total number of reads of all registers.
+   */
+  size_t Reads() const { return reads_; }
+  /**
+   * Returns the total number of writes to all registers.
+   */
+  size_t Writes() const { return writes_; }
+  /**
+   * Resets all access counters to zero.
+   */
+  void ClearCounts();
+
+  uint8_t Read8(ptrdiff_t offset) override;
+  uint32_t Read32(ptrdiff_t offset) override;
+
+  void Write8(ptrdiff_t offset, uint8_t value) override;
+  void Write32(ptrdiff_t offset, uint32_t value) override;
+
+ private:
+  enum class Model {
+    kRw,
+    kRo,
+    kW1c,
+    kFifo,
+  };
+
+  struct Register {
+    Model model;
+    uint32_t value;
+    std::deque<uint32_t> fifo;
+    ReadCallback on_read;
+    WriteCallback on_write;
+    size_t reads;
+    size_t writes;
+  };
+
+  void Declare(ptrdiff_t offset, Model model, uint32_t reset);
+  Register *Find(ptrdiff_t offset);
+
+  std::map<ptrdiff_t, Register> regs_;
+  size_t reads_ = 0;
+  size_t writes_ = 0;
+};
+
+/**
+ * Convenience fixture for creating device tests with a `RegisterFileDevice`.
+ *
+ * This class should be derived by a test fixture (along with `testing::Test`)
+ * and used in a `TEST_F` block, in place of `MmioTest`. The device can be
+ * accessed in the test body with `this->dev()`.
+ */
+class RegisterFileTest {
+ protected:
+  RegisterFileDevice &dev() { return dev_; }
+
+ private:
+  RegisterFileDevice dev_;
+};
+}  // namespace mock_mmio
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_BASE_MOCK_MMIO_REGFILE_H_
@@ -0,0 +1,110 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/mock_mmio_regfile.h"
+
+#include "gtest/gtest-spi.h"
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/mmio.h"
+
+namespace {
+using ::mock_mmio::RegisterFileTest;
+using ::testing::ElementsAre;
+using ::testing::Test;
+
+enum {
+  kCtrl = 0x0,
+  kStatus = 0x4,
+  kIntrState = 0x8,
+  kData = 0xc,
+};
+
+class RegisterFileDeviceTest : public Test, public RegisterFileTest {};
+
+TEST_F(RegisterFileDeviceTest, Rw) {
+  dev().Rw(kCtrl, 0x5);
+  EXPECT_EQ(mmio_region_read32(dev().region(), kCtrl), 0x5);
+  mmio_region_write32(dev().region(), kCtrl, 0xdeadbeef);
+  EXPECT_EQ(mmio_region_read32(dev().region(), kCtrl), 0xdeadbeef);
+  EXPECT_EQ(mmio_region_read8(dev().region(), kCtrl), 0xef);
+}
+
+TEST_F(RegisterFileDeviceTest, Ro) {
+  dev().Ro(kStatus, 0x1);
+  mmio_region_write32(dev().region(), kStatus, 0x0);
+  EXPECT_EQ(mmio_region_read32(dev().region(), kStatus), 0x1);
+  dev().Set(kStatus, 0x2);
+  EXPECT_EQ(mmio_region_read32(dev().region(), kStatus), 0x2);
+}
+
+TEST_F(RegisterFileDeviceTest, W1c) {
+  dev().W1c(kIntrState, 0x7);
+  mmio_region_write32(dev().region(), kIntrState, 0x2);
+  EXPECT_EQ(dev().Get(kIntrState), 0x5);
+}
+
+TEST_F(RegisterFileDeviceTest, Fifo) {
+  dev().Fifo(kData);
+  dev().FifoData(kData).push_back(0x11);
+  dev().FifoData(kData).push_back(0x22);
+  EXPECT_EQ(mmio_region_read32(dev().region(), kData), 0x11);
+  EXPECT_EQ(mmio_region_read32(dev().region(), kData), 0x22);
+  EXPECT_NONFATAL_FAILURE(
+      OT_DISCARD(mmio_region_read32(dev().region(), kData)), "empty FIFO");
+
+  mmio_region_write32(dev().region(), kData, 0x33);
+  mmio_region_write8(dev().region(), kData, 0x44);
+  EXPECT_THAT(dev().FifoData(kData), ElementsAre(0x33, 0x44));
+}
+
+TEST_F(RegisterFileDeviceTest, Undeclared) {
+  EXPECT_NONFATAL_FAILURE(
+      OT_DISCARD(mmio_region_read32(dev().region(), kCtrl)), "undeclared");
+  EXPECT_NONFATAL_FAILURE(mmio_region_write32(dev().region(), kCtrl, 0),
+                          "undeclared");
+}
+
+TEST_F(RegisterFileDeviceTest, Callbacks) {
+  // The status register reports the FIFO level, and writing to the control
+  // register flushes the FIFO.
+  dev().Ro(kStatus);
+  dev().Rw(kCtrl);
+  dev().Fifo(kData);
+  dev().OnRead(kStatus,
+               [&] { dev().Set(kStatus, dev().FifoData(kData).size()); });
+  dev().OnWrite(kCtrl, [&](uint32_t value) {
+    if (value & 1) {
+      dev().FifoData(kData).clear();
+    }
+  });
+
+  mmio_region_write32(dev().region(), kData, 1);
+  mmio_region_write32(dev().region(), kData, 2);
+  EXPECT_EQ(mmio_region_read32(dev().region(), kStatus), 2);
+  mmio_region_write32(dev().region(), kCtrl, 1);
+  EXPECT_EQ(mmio_region_read32(dev().region(), kStatus), 0);
+}
+
+TEST_F(RegisterFileDeviceTest, Counts) {
+  dev().Rw(kCtrl);
+  dev().Fifo(kData);
+  for (uint32_t i = 0; i < 100; ++i) {
+    mmio_region_write32(dev().region(), kData, i);
+  }
+  mmio_region_write32_shadowed(dev().region(), kCtrl, 1);
+  EXPECT_EQ(mmio_region_read32(dev().region(), kCtrl), 1);
+
+  EXPECT_EQ(dev().Writes(kData), 100);
+  EXPECT_EQ(dev().Writes(kCtrl), 2);
+  EXPECT_EQ(dev().Reads(kCtrl), 1);
+  EXPECT_EQ(dev().Writes(), 102);
+  EXPECT_EQ(dev().Reads(), 1);
+
+  dev().ClearCounts();
+  EXPECT_EQ(dev().Writes(kData), 0);
+  EXPECT_EQ(dev().Writes(), 0);
+  EXPECT_EQ(dev().Reads(), 0);
+}
+}  // namespace
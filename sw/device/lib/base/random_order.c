@@ -4,16 +4,78 @@
 
 #include "sw/device/lib/base/random_order.h"
 
-#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/csr.h"
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/macros.h"
 
-// TODO: The current implementation is just a skeleton, and currently just
-// traverses from 0 to `min_len * 2`.
+OT_WEAK
+uint32_t random_order_random_word(void) {
+#ifdef OT_PLATFORM_RV32
+  uint32_t mcycle;
+  CSR_READ(CSR_REG_MCYCLE, &mcycle);
+  return mcycle;
+#else
+  return 0x9e3779b9;
+#endif
+}
+
+/**
+ * Returns the greatest common divisor of `a` and `b`.
+ */
+static size_t gcd(size_t a, size_t b) {
+  while (b != 0) {
+    size_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
 
 void random_order_init(random_order_t *ctx, size_t min_len) {
+  random_order_init_decoys(ctx, min_len, kRandomOrderDefaultDecoyPercent);
+}
+
+void random_order_init_decoys(random_order_t *ctx, size_t min_len,
+                              size_t decoy_percent) {
+  ctx->max = min_len + min_len * decoy_percent / 100;
   ctx->state = 0;
-  ctx->max = min_len * 2;
+  ctx->step = 1;
+  if (ctx->max <= 1) {
+    return;
+  }
+
+  ctx->state = random_order_random_word() % ctx->max;
+
+  // Any step in `1..max` that is coprime to `max` generates a permutation of
+  // `0..max`. The candidate steps only depend on `max`, and the random word
+  // picks one of them or its negation without branching on it, so that the
+  // time taken does not reveal the step.
+  size_t steps[kRandomOrderStepCandidates];
+  size_t num_steps = 0;
+  for (size_t step = 1;
+       step < ctx->max && num_steps < kRandomOrderStepCandidates; ++step) {
+    if (gcd(step, ctx->max) == 1) {
+      steps[num_steps++] = step;
+    }
+  }
+
+  uint32_t word = random_order_random_word();
+  size_t index = word % num_steps;
+  size_t step = steps[0];
+  for (size_t i = 1; i < num_steps; ++i) {
+    step = ct_cmovw(ct_seqw(i, index), steps[i], step);
+  }
+  ctx->step = ct_cmovw(ct_seqzw(word >> 31), step, ctx->max - step);
 }
 
 size_t random_order_len(const random_order_t *ctx) { return ctx->max; }
 
-size_t random_order_advance(random_order_t *ctx) { return ctx->state++; }
+size_t random_order_advance(random_order_t *ctx) {
+  size_t value = ctx->state;
+  // `state` and `step` are both less than `max`, so a single conditional
+  // subtraction reduces the sum. The subtraction is branchless so that the
+  // wrap-around point does not show up in the timing.
+  size_t next = value + ctx->step;
+  ctx->state = next - ct_cmovw(ct_sltuw(next, ctx->max), 0, ctx->max);
+  return value;
+}
@@ -6,6 +6,7 @@
 #define OPENTITAN_SW_DEVICE_LIB_BASE_RANDOM_ORDER_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,12 +32,42 @@ extern "C" {
  * Users must be mindful of these constraints when using `random_order_t`.
  * These caveats are intended to allow for implementation flexibility, such as
  * intentionally adding decoys to the sequence.
+ *
+ * The current implementation visits every integer in `0..m` exactly once, in
+ * the order `(offset + i * step) % m` for a random `offset` and a `step`
+ * coprime to `m`, picked at random among a few small candidates and their
+ * negations. The values in `n..m` are decoys.
  */
 typedef struct random_order {
   size_t state;
+  size_t step;
   size_t max;
 } random_order_t;
 
+enum {
+  /**
+   * Decoy ratio used by `random_order_init()`, in percent of `min_len`.
+   */
+  kRandomOrderDefaultDecoyPercent = 100,
+  /**
+   * Number of steps that a random order chooses from, not counting their
+   * negations.
+   */
+  kRandomOrderStepCandidates = 8,
+};
+
+/**
+ * Returns a random word used to seed random orders.
+ *
+ * The default implementation reads the MCYCLE CSR, which is not a good source
+ * of randomness. It is a weak symbol that should be replaced at link-time by
+ * a platform with access to an entropy source, such as the Ibex RND_DATA
+ * register.
+ *
+ * @return A random word.
+ */
+uint32_t random_order_random_word(void);
+
 /**
  * Constructs a new, randomly-seeded traversal order,
  * running from `0` to at least `min_len`.
@@ -44,11 +75,29 @@ typedef struct random_order {
  * This function does not take a seed as input; instead, the seed is
  * extracted, in some manner or another, from the hardware by this function.
  *
+ * This is equivalent to `random_order_init_decoys()` with
+ * `kRandomOrderDefaultDecoyPercent`.
+ *
  * @param ctx The context to initialize.
  * @param min_len The minimum length this traversal order must visit.
  */
 void random_order_init(random_order_t *ctx, size_t min_len);
 
+/**
+ * Constructs a new, randomly-seeded traversal order with a given number of
+ * decoys.
+ *
+ * The sequence has `min_len + min_len * decoy_percent / 100` elements. More
+ * decoys make side-channel analysis harder, at the cost of proportionally
+ * more iterations in the caller.
+ *
+ * @param ctx The context to initialize.
+ * @param min_len The minimum length this traversal order must visit.
+ * @param decoy_percent The number of decoys, in percent of `min_len`.
+ */
+void random_order_init_decoys(random_order_t *ctx, size_t min_len,
+                              size_t decoy_percent);
+
 /**
  * Returns the length of the sequence represented by `ctx`.
  *
@@ -0,0 +1,70 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/random_order.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace random_order_unittest {
+namespace {
+
+uint32_t random_word = 0;
+
+// Override the default randomness source so that tests can vary the seed.
+extern "C" uint32_t random_order_random_word() { return random_word; }
+
+std::vector<size_t> Traverse(size_t min_len, size_t decoy_percent) {
+  random_order_t order;
+  random_order_init_decoys(&order, min_len, decoy_percent);
+  std::vector<size_t> values;
+  for (size_t i = 0; i < random_order_len(&order); ++i) {
+    values.push_back(random_order_advance(&order));
+  }
+  return values;
+}
+
+class PermutationTest
+    : public testing::TestWithParam<std::tuple<size_t, size_t, uint32_t>> {};
+
+TEST_P(PermutationTest, VisitsEveryIndexOnce) {
+  size_t min_len = std::get<0>(GetParam());
+  size_t decoy_percent = std::get<1>(GetParam());
+  random_word = std::get<2>(GetParam());
+
+  std::vector<size_t> values = Traverse(min_len, decoy_percent);
+  size_t len = min_len + min_len * decoy_percent / 100;
+  EXPECT_EQ(values.size(), len);
+
+  std::sort(values.begin(), values.end());
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllLengths, PermutationTest,
+    testing::Combine(testing::Values(0, 1, 2, 3, 8, 12, 31, 64),
+                     testing::Values(0, 25, 50, 100),
+                     testing::Values(0, 1, 6, 0x9e3779b9, UINT32_MAX)));
+
+TEST(RandomOrder, DefaultDoublesLength) {
+  random_order_t order;
+  random_order_init(&order, 10);
+  EXPECT_EQ(random_order_len(&order), 20);
+}
+
+TEST(RandomOrder, SeedChangesOrder) {
+  random_word = 3;
+  std::vector<size_t> a = Traverse(16, 0);
+  random_word = 5;
+  std::vector<size_t> b = Traverse(16, 0);
+  EXPECT_NE(a, b);
+}
+
+}  // namespace
+}  // namespace random_order_unittest
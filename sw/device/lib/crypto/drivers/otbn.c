@@ -61,6 +61,61 @@ typedef enum otbn_status {
   kOtbnStatusLocked = 0xFF,
 } otbn_status_t;
 
+/**
+ * Tracks which application image is resident in IMEM.
+ *
+ * `otbn_load_app()` skips rewriting IMEM when the requested application was
+ * the last one loaded and IMEM still holds its image when read back. The image
+ * is not read back right after it is written: the check happens when it is
+ * about to be reused.
+ *
+ * The LOAD_CHECKSUM value recorded after this driver's last write to OTBN
+ * memory is only used to decide early that a reload is needed: the register is
+ * writable by software, so a matching value does not show that IMEM is
+ * unchanged.
+ */
+typedef struct otbn_residency {
+  /**
+   * Start of the resident application's instruction memory image.
+   */
+  const uint32_t *imem_start;
+  /**
+   * End of the resident application's instruction memory image.
+   */
+  const uint32_t *imem_end;
+  /**
+   * LOAD_CHECKSUM value after this driver's last write to OTBN memory.
+   *
+   * Reload-skip heuristic only, see `app_is_resident()`.
+   */
+  uint32_t load_checksum;
+  /**
+   * Whether the fields above describe the contents of IMEM.
+   *
+   * Set to `kHardenedBoolTrue` if valid, any other value otherwise.
+   */
+  hardened_bool_t valid;
+} otbn_residency_t;
+
+static otbn_residency_t residency;
+
+/**
+ * Forgets the resident application, forcing the next load to rewrite IMEM.
+ */
+static void residency_invalidate(void) {
+  residency.valid = kHardenedBoolFalse;
+  residency.imem_start = NULL;
+  residency.imem_end = NULL;
+}
+
+/**
+ * Records the load checksum after a write to OTBN memory by this driver.
+ */
+static void residency_checksum_update(void) {
+  residency.load_checksum =
+      abs_mmio_read32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET);
+}
+
 /**
  * Ensures that a memory access fits within the given memory size.
  *
@@ -146,6 +201,7 @@ status_t otbn_dmem_write(size_t num_words, const uint32_t *src,
                          otbn_addr_t dest) {
   HARDENED_TRY(check_offset_len(dest, num_words, kOtbnDMemSizeBytes));
   otbn_write(kBase + OTBN_DMEM_REG_OFFSET + dest, src, num_words);
+  residency_checksum_update();
   return OTCRYPTO_OK;
 }
 
@@ -160,6 +216,7 @@ status_t otbn_dmem_set(size_t num_words, const uint32_t src, otbn_addr_t dest) {
     HARDENED_CHECK_LT(i, num_words);
   }
   HARDENED_CHECK_EQ(i, num_words);
+  residency_checksum_update();
   return OTCRYPTO_OK;
 }
 
@@ -205,6 +262,9 @@ status_t otbn_busy_wait_for_done(void) {
     return res;
   }
 
+  // Don't trust the resident application after an error.
+  residency_invalidate();
+
   // If OTBN is idle (not locked), then return a recoverable error.
   if (launder32(status) == kOtbnStatusIdle) {
     HARDENED_CHECK_EQ(status, kOtbnStatusIdle);
@@ -226,6 +286,7 @@ uint32_t otbn_instruction_count_get(void) {
 
 status_t otbn_imem_sec_wipe(void) {
   HARDENED_TRY(otbn_assert_idle());
+  residency_invalidate();
   abs_mmio_write32(kBase + OTBN_CMD_REG_OFFSET, kOtbnCmdSecWipeImem);
   HARDENED_TRY(otbn_busy_wait_for_done());
   return OTCRYPTO_OK;
@@ -283,6 +344,59 @@ static status_t check_app_address_ranges(const otbn_app_t *app) {
   return OTCRYPTO_OK;
 }
 
+/**
+ * Checks that IMEM holds the given application image.
+ *
+ * @param app The application to check.
+ * @return `OTCRYPTO_OK` if IMEM matches the image, otherwise
+ * `OTCRYPTO_RECOV_ERR`.
+ */
+static status_t imem_check(const otbn_app_t *app) {
+  const size_t num_words = app->imem_end - app->imem_start;
+  uint32_t diff = 0;
+  size_t i = 0;
+  for (; launder32(i) < num_words; ++i) {
+    uint32_t addr = kBase + OTBN_IMEM_REG_OFFSET + i * sizeof(uint32_t);
+    diff |= app->imem_start[i] ^ abs_mmio_read32(addr);
+  }
+  HARDENED_CHECK_EQ(i, num_words);
+  if (launder32(diff) != 0) {
+    return OTCRYPTO_RECOV_ERR;
+  }
+  HARDENED_CHECK_EQ(diff, 0);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Whether `app` is resident in IMEM.
+ *
+ * A changed LOAD_CHECKSUM means that OTBN memory was written or OTBN was reset
+ * since this driver's last write, so the image is not read back in that case.
+ * An unchanged LOAD_CHECKSUM proves nothing since software can write the
+ * register, so IMEM is always compared against the image before it is reused.
+ *
+ * @param app The application to check.
+ * @return `kHardenedBoolTrue` if IMEM need not be reloaded.
+ */
+static hardened_bool_t app_is_resident(const otbn_app_t *app) {
+  if (launder32(residency.valid) != kHardenedBoolTrue ||
+      residency.imem_start != app->imem_start ||
+      residency.imem_end != app->imem_end) {
+    return kHardenedBoolFalse;
+  }
+  uint32_t checksum = abs_mmio_read32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET);
+  if (launder32(checksum) != residency.load_checksum) {
+    return kHardenedBoolFalse;
+  }
+  HARDENED_CHECK_EQ(checksum, residency.load_checksum);
+  status_t res = imem_check(app);
+  if (launder32(hardened_status_ok(res)) != kHardenedBoolTrue) {
+    return kHardenedBoolFalse;
+  }
+  HARDENED_CHECK_EQ(hardened_status_ok(res), kHardenedBoolTrue);
+  return kHardenedBoolTrue;
+}
+
 status_t otbn_load_app(const otbn_app_t app) {
   HARDENED_TRY(check_app_address_ranges(&app));
 
@@ -292,13 +406,24 @@ status_t otbn_load_app(const otbn_app_t app) {
   const size_t imem_num_words = app.imem_end - app.imem_start;
   const size_t data_num_words = app.dmem_data_end - app.dmem_data_start;
 
-  HARDENED_TRY(otbn_imem_sec_wipe());
-  HARDENED_TRY(otbn_dmem_sec_wipe());
-
-  // IMEM always starts at zero.
-  otbn_addr_t imem_start_addr = 0;
-  HARDENED_TRY(
-      otbn_imem_write(imem_num_words, app.imem_start, imem_start_addr));
+  if (launder32(app_is_resident(&app)) == kHardenedBoolTrue) {
+    // Only the DMEM state of the previous run needs to go.
+    HARDENED_TRY(otbn_dmem_sec_wipe());
+  } else {
+    residency_invalidate();
+    HARDENED_TRY(otbn_imem_sec_wipe());
+    HARDENED_TRY(otbn_dmem_sec_wipe());
+
+    // IMEM always starts at zero.
+    otbn_addr_t imem_start_addr = 0;
+    HARDENED_TRY(
+        otbn_imem_write(imem_num_words, app.imem_start, imem_start_addr));
+
+    residency.imem_start = app.imem_start;
+    residency.imem_end = app.imem_end;
+    residency_checksum_update();
+    residency.valid = kHardenedBoolTrue;
+  }
 
   if (data_num_words > 0) {
     HARDENED_TRY(otbn_dmem_write(data_num_words, app.dmem_data_start,
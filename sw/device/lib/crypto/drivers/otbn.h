@@ -306,6 +306,16 @@ status_t otbn_set_ctrl_software_errs_fatal(bool enable);
  * Load the application image with both instruction and data segments into
  * OTBN.
  *
+ * If the same application was the last one loaded, its instruction segment is
+ * read back from IMEM and compared with the image. If it still matches, the
+ * IMEM secure wipe and rewrite are skipped and only DMEM is wiped and
+ * reloaded. The read-back costs one IMEM read per instruction word, so reuse
+ * saves the wipe and the IMEM writes but not the IMEM accesses.
+ *
+ * Any other application, a change in OTBN's load checksum since this driver's
+ * last memory write, an OTBN error or `otbn_imem_sec_wipe()` forces a full
+ * reload, without the read-back.
+ *
  * This function will return an error if called when OTBN is not idle.
  *
  * @param ctx The context object.
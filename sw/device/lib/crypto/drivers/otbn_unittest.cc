@@ -0,0 +1,248 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/drivers/otbn.h"
+
+#include <array>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/crypto/impl/status.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+#include "otbn_regs.h"  // Generated.
+
+namespace otbn_unittest {
+namespace {
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Invoke;
+
+enum {
+  kBase = TOP_EARLGREY_OTBN_BASE_ADDR,
+  kImem = kBase + OTBN_IMEM_REG_OFFSET,
+  kDmem = kBase + OTBN_DMEM_REG_OFFSET,
+  kCmdSecWipeImem = 0x1e,
+  kCmdSecWipeDmem = 0xc3,
+  kCmdExecute = 0xd8,
+  kStatusIdle = 0x00,
+};
+
+/**
+ * Behavioural model of the OTBN registers and memories used by the driver.
+ *
+ * Commands complete immediately. LOAD_CHECKSUM changes on every IMEM and DMEM
+ * write and can be overwritten by software, like the hardware register.
+ */
+class OtbnModel {
+ public:
+  uint32_t Read32(uint32_t addr) {
+    if (addr >= kImem && addr < kImem + OTBN_IMEM_SIZE_BYTES) {
+      ++imem_reads;
+      return imem[(addr - kImem) / sizeof(uint32_t)];
+    }
+    if (addr >= kDmem && addr < kDmem + OTBN_DMEM_SIZE_BYTES) {
+      return dmem[(addr - kDmem) / sizeof(uint32_t)];
+    }
+    switch (addr - kBase) {
+      case OTBN_STATUS_REG_OFFSET:
+        return kStatusIdle;
+      case OTBN_ERR_BITS_REG_OFFSET:
+        return err_bits;
+      case OTBN_LOAD_CHECKSUM_REG_OFFSET:
+        return load_checksum;
+      default:
+        ADD_FAILURE() << "Unexpected read at 0x" << std::hex << addr;
+        return 0;
+    }
+  }
+
+  void Write32(uint32_t addr, uint32_t value) {
+    if (addr >= kImem && addr < kImem + OTBN_IMEM_SIZE_BYTES) {
+      ++imem_writes;
+      imem[(addr - kImem) / sizeof(uint32_t)] = value;
+      load_checksum = load_checksum * 31 + addr + value;
+      return;
+    }
+    if (addr >= kDmem && addr < kDmem + OTBN_DMEM_SIZE_BYTES) {
+      dmem[(addr - kDmem) / sizeof(uint32_t)] = value;
+      load_checksum = load_checksum * 31 + addr + value;
+      return;
+    }
+    switch (addr - kBase) {
+      case OTBN_CMD_REG_OFFSET:
+        if (value == kCmdSecWipeImem) {
+          ++imem_wipes;
+          imem.fill(0xa5a5a5a5);
+        } else if (value == kCmdSecWipeDmem) {
+          dmem.fill(0x5a5a5a5a);
+        } else {
+          EXPECT_EQ(value, kCmdExecute);
+        }
+        return;
+      case OTBN_LOAD_CHECKSUM_REG_OFFSET:
+        load_checksum = value;
+        return;
+      default:
+        ADD_FAILURE() << "Unexpected write at 0x" << std::hex << addr;
+    }
+  }
+
+  std::array<uint32_t, OTBN_IMEM_SIZE_BYTES / sizeof(uint32_t)> imem{};
+  std::array<uint32_t, OTBN_DMEM_SIZE_BYTES / sizeof(uint32_t)> dmem{};
+  uint32_t err_bits = 0;
+  uint32_t load_checksum = 0;
+  size_t imem_reads = 0;
+  size_t imem_writes = 0;
+  size_t imem_wipes = 0;
+};
+
+class OtbnLoadAppTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    EXPECT_CALL(abs_mmio_, Read32(_))
+        .Times(AnyNumber())
+        .WillRepeatedly(Invoke(&otbn_, &OtbnModel::Read32));
+    EXPECT_CALL(abs_mmio_, Write32(_, _))
+        .Times(AnyNumber())
+        .WillRepeatedly(Invoke(&otbn_, &OtbnModel::Write32));
+    // Start every test without a resident app.
+    ASSERT_EQ(otbn_imem_sec_wipe().value, OTCRYPTO_OK.value);
+    ClearCounts();
+  }
+
+  void ClearCounts() {
+    otbn_.imem_reads = 0;
+    otbn_.imem_writes = 0;
+    otbn_.imem_wipes = 0;
+  }
+
+  /**
+   * Loads `app_` and checks that OTBN memories hold its image afterwards.
+   */
+  void LoadApp() {
+    EXPECT_EQ(otbn_load_app(app_).value, OTCRYPTO_OK.value);
+    for (size_t i = 0; i < imem_image_.size(); ++i) {
+      EXPECT_EQ(otbn_.imem[i], imem_image_[i]);
+    }
+    for (size_t i = 0; i < dmem_image_.size(); ++i) {
+      EXPECT_EQ(otbn_.dmem[kDmemDataWord + i], dmem_image_[i]);
+    }
+  }
+
+  /**
+   * Checks whether the last load rewrote IMEM.
+   */
+  void ExpectFullReload(bool full) {
+    if (full) {
+      EXPECT_EQ(otbn_.imem_wipes, 1);
+      EXPECT_EQ(otbn_.imem_writes, imem_image_.size());
+    } else {
+      EXPECT_EQ(otbn_.imem_wipes, 0);
+      EXPECT_EQ(otbn_.imem_writes, 0);
+    }
+  }
+
+  static constexpr size_t kDmemDataWord = 4;
+  std::array<uint32_t, 16> imem_image_ = {
+      0x00000013, 0x11111111, 0x22222222, 0x33333333, 0x44444444, 0x55555555,
+      0x66666666, 0x77777777, 0x88888888, 0x99999999, 0xaaaaaaaa, 0xbbbbbbbb,
+      0xcccccccc, 0xdddddddd, 0xeeeeeeee, 0x0000006f,
+  };
+  std::array<uint32_t, 3> dmem_image_ = {0xd0, 0xd1, 0xd2};
+  otbn_app_t app_ = {
+      .imem_start = imem_image_.data(),
+      .imem_end = imem_image_.data() + imem_image_.size(),
+      .dmem_data_start = dmem_image_.data(),
+      .dmem_data_end = dmem_image_.data() + dmem_image_.size(),
+      .dmem_data_start_addr = kDmemDataWord * sizeof(uint32_t),
+  };
+  rom_test::MockAbsMmio abs_mmio_;
+  OtbnModel otbn_;
+};
+
+// Checks the cost of each path: the first load writes IMEM without reading it
+// back, and reusing the resident app reads the whole image back instead of
+// wiping and rewriting it.
+TEST_F(OtbnLoadAppTest, ReuseReadsImageBack) {
+  LoadApp();
+  ExpectFullReload(true);
+  EXPECT_EQ(otbn_.imem_reads, 0);
+
+  ClearCounts();
+  LoadApp();
+  ExpectFullReload(false);
+  EXPECT_EQ(otbn_.imem_reads, imem_image_.size());
+}
+
+TEST_F(OtbnLoadAppTest, ForeignImemWriteForcesReload) {
+  LoadApp();
+  abs_mmio_write32(kImem + 8, 0xdeadbeef);
+
+  ClearCounts();
+  LoadApp();
+  ExpectFullReload(true);
+  // The changed load checksum is enough to decide, IMEM is not read back.
+  EXPECT_EQ(otbn_.imem_reads, 0);
+}
+
+// Software can write LOAD_CHECKSUM, so a foreign IMEM write that restores it
+// must still be caught by the read-back.
+TEST_F(OtbnLoadAppTest, ForeignImemWriteWithChecksumRestoredForcesReload) {
+  LoadApp();
+  uint32_t checksum = otbn_.load_checksum;
+  abs_mmio_write32(kImem + 8, 0xdeadbeef);
+  abs_mmio_write32(kBase + OTBN_LOAD_CHECKSUM_REG_OFFSET, checksum);
+
+  ClearCounts();
+  LoadApp();
+  ExpectFullReload(true);
+  EXPECT_EQ(otbn_.imem_reads, imem_image_.size());
+}
+
+TEST_F(OtbnLoadAppTest, ErrorForcesReload) {
+  LoadApp();
+  EXPECT_EQ(otbn_execute().value, OTCRYPTO_OK.value);
+  otbn_.err_bits = 1 << OTBN_ERR_BITS_BAD_INSN_ADDR_BIT;
+  EXPECT_EQ(status_err(otbn_busy_wait_for_done()), kAborted);
+  otbn_.err_bits = 0;
+
+  ClearCounts();
+  LoadApp();
+  ExpectFullReload(true);
+  EXPECT_EQ(otbn_.imem_reads, 0);
+}
+
+TEST_F(OtbnLoadAppTest, ImemSecWipeForcesReload) {
+  LoadApp();
+  EXPECT_EQ(otbn_imem_sec_wipe().value, OTCRYPTO_OK.value);
+
+  ClearCounts();
+  LoadApp();
+  // One wipe from `otbn_load_app()` itself.
+  ExpectFullReload(true);
+  EXPECT_EQ(otbn_.imem_reads, 0);
+}
+
+TEST_F(OtbnLoadAppTest, OtherAppForcesReload) {
+  LoadApp();
+  std::array<uint32_t, 4> other_image = {1, 2, 3, 4};
+  otbn_app_t other = {
+      .imem_start = other_image.data(),
+      .imem_end = other_image.data() + other_image.size(),
+      .dmem_data_start = nullptr,
+      .dmem_data_end = nullptr,
+      .dmem_data_start_addr = 0,
+  };
+  EXPECT_EQ(otbn_load_app(other).value, OTCRYPTO_OK.value);
+
+  ClearCounts();
+  LoadApp();
+  ExpectFullReload(true);
+  EXPECT_EQ(otbn_.imem_reads, 0);
+}
+
+}  // namespace
+}  // namespace otbn_unittest
@@ -6,6 +6,8 @@
 
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/base/hardened_memory.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/drivers/hmac.h"
 #include "sw/device/lib/crypto/drivers/otbn.h"
 
 #include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
@@ -115,7 +117,15 @@ status_t ecdsa_p256_sign_start(const uint32_t digest[kP256ScalarWords],
   return otbn_execute();
 }
 
-status_t ecdsa_p256_sign_finalize(ecdsa_p256_signature_t *result) {
+/**
+ * Waits for a signing run to complete and reads the signature from DMEM.
+ *
+ * Leaves DMEM as it is; the caller is responsible for wiping it.
+ *
+ * @param[out] result Buffer in which to store the generated signature.
+ * @return Result of the operation (OK or error).
+ */
+static status_t sign_result_read(ecdsa_p256_signature_t *result) {
   // Spin here waiting for OTBN to complete.
   HARDENED_TRY(otbn_busy_wait_for_done());
 
@@ -125,12 +135,105 @@ status_t ecdsa_p256_sign_finalize(ecdsa_p256_signature_t *result) {
   // Read signature S out of OTBN dmem.
   HARDENED_TRY(otbn_dmem_read(kP256ScalarWords, kOtbnVarEcdsaS, result->s));
 
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Wipes DMEM after a failed signing operation and passes the error on.
+ *
+ * The wipe fails if OTBN is busy or locked; in the latter case OTBN has
+ * already wiped its memories. Either way, `err` is the error to report.
+ *
+ * @param err Error of the failed operation.
+ * @return `err`.
+ */
+static status_t sign_error_wipe(status_t err) {
+  OT_DISCARD(status_ok(otbn_dmem_sec_wipe()));
+  return err;
+}
+
+status_t ecdsa_p256_sign_finalize(ecdsa_p256_signature_t *result) {
+  status_t err = sign_result_read(result);
+  if (launder32(hardened_status_ok(err)) != kHardenedBoolTrue) {
+    return sign_error_wipe(err);
+  }
+  HARDENED_CHECK_EQ(hardened_status_ok(err), kHardenedBoolTrue);
+
   // Wipe DMEM.
   HARDENED_TRY(otbn_dmem_sec_wipe());
 
   return OTCRYPTO_OK;
 }
 
+/**
+ * Computes the SHA-256 digest of a message with the HMAC block.
+ *
+ * @param message Message to hash.
+ * @param[out] digest Buffer for the digest.
+ */
+static void message_digest(const ecdsa_p256_message_t *message,
+                           hmac_digest_t *digest) {
+  hmac_sha256_init();
+  hmac_update(message->data, message->len);
+  hmac_final(digest);
+}
+
+/**
+ * Runs the signing pipeline of `ecdsa_p256_sign_batch()`.
+ *
+ * Leaves DMEM as it is if an intermediate run fails; the caller is
+ * responsible for wiping it.
+ *
+ * @param messages Messages to sign, at least one.
+ * @param num_messages Number of messages in the batch.
+ * @param private_key Secret key to sign the messages with.
+ * @param[out] signatures Buffer for `num_messages` signatures.
+ * @return Result of the operation (OK or error).
+ */
+static status_t sign_batch_run(const ecdsa_p256_message_t *messages,
+                               size_t num_messages,
+                               const p256_masked_scalar_t *private_key,
+                               ecdsa_p256_signature_t *signatures) {
+  hmac_digest_t digest;
+  message_digest(&messages[0], &digest);
+  HARDENED_TRY(ecdsa_p256_sign_start(digest.digest, private_key));
+
+  size_t i = 0;
+  for (; launder32(i) < num_messages - 1; ++i) {
+    // Hash the next message on the HMAC block while OTBN signs this one.
+    message_digest(&messages[i + 1], &digest);
+
+    // Collect this signature and start on the next message straight away.
+    // Loading the (already resident) app wipes the previous run's DMEM.
+    HARDENED_TRY(sign_result_read(&signatures[i]));
+    HARDENED_TRY(ecdsa_p256_sign_start(digest.digest, private_key));
+  }
+  HARDENED_CHECK_EQ(i, num_messages - 1);
+
+  return ecdsa_p256_sign_finalize(&signatures[i]);
+}
+
+status_t ecdsa_p256_sign_batch(const ecdsa_p256_message_t *messages,
+                               size_t num_messages,
+                               const p256_masked_scalar_t *private_key,
+                               ecdsa_p256_signature_t *signatures) {
+  if (num_messages == 0) {
+    return OTCRYPTO_OK;
+  }
+  if (messages == NULL || private_key == NULL || signatures == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Don't leave the private key or a signature in DMEM if a run fails.
+  status_t err =
+      sign_batch_run(messages, num_messages, private_key, signatures);
+  if (launder32(hardened_status_ok(err)) != kHardenedBoolTrue) {
+    return sign_error_wipe(err);
+  }
+  HARDENED_CHECK_EQ(hardened_status_ok(err), kHardenedBoolTrue);
+  return err;
+}
+
 status_t ecdsa_p256_verify_start(const ecdsa_p256_signature_t *signature,
                                  const uint32_t digest[kP256ScalarWords],
                                  const p256_point_t *public_key) {
@@ -169,7 +272,8 @@ status_t ecdsa_p256_verify_finalize(const ecdsa_p256_signature_t *signature,
   uint32_t x_r[kP256ScalarWords];
   HARDENED_TRY(otbn_dmem_read(kP256ScalarWords, kOtbnVarEcdsaXr, x_r));
 
-  *result = hardened_memeq(x_r, signature->r, kP256ScalarWords);
+  // Both values are public, so decoy comparisons would not add protection.
+  *result = hardened_memeq_decoys(x_r, signature->r, kP256ScalarWords, 0);
 
   // Wipe DMEM.
   HARDENED_TRY(otbn_dmem_sec_wipe());
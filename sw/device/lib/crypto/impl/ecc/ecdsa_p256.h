@@ -26,6 +26,20 @@ typedef struct ecdsa_p256_signature_t {
   uint32_t s[kP256ScalarWords];
 } ecdsa_p256_signature_t;
 
+/**
+ * A message to be hashed and signed by `ecdsa_p256_sign_batch()`.
+ */
+typedef struct ecdsa_p256_message {
+  /**
+   * Message bytes.
+   */
+  const uint8_t *data;
+  /**
+   * Length of the message in bytes.
+   */
+  size_t len;
+} ecdsa_p256_message_t;
+
 /**
  * Start an async ECDSA/P-256 keypair generation operation on OTBN.
  *
@@ -64,13 +78,37 @@ status_t ecdsa_p256_sign_start(const uint32_t digest[kP256ScalarWords],
  *
  * See the documentation of `ecdsa_p256_sign` for details.
  *
- * Blocks until OTBN is idle.
+ * Blocks until OTBN is idle. DMEM is wiped whether or not the operation
+ * succeeds.
  *
  * @param[out] result Buffer in which to store the generated signature.
  * @return Result of the operation (OK or error).
  */
 status_t ecdsa_p256_sign_finalize(ecdsa_p256_signature_t *result);
 
+/**
+ * Hash and sign a batch of messages with the same private key.
+ *
+ * Each message is hashed with SHA-256 on the HMAC block and signed on OTBN.
+ * The two are pipelined: while OTBN signs message i, Ibex hashes message i+1,
+ * then reads signature i and immediately starts OTBN on message i+1. OTBN
+ * DMEM is wiped between messages and after the last one, and also when any of
+ * the runs fails.
+ *
+ * This is a blocking call. OTBN must be idle, and the HMAC block must not be
+ * in use by anything else for the duration of the batch.
+ *
+ * @param messages Messages to sign.
+ * @param num_messages Number of messages in the batch.
+ * @param private_key Secret key to sign the messages with.
+ * @param[out] signatures Buffer for `num_messages` signatures.
+ * @return Result of the operation (OK or error).
+ */
+status_t ecdsa_p256_sign_batch(const ecdsa_p256_message_t *messages,
+                               size_t num_messages,
+                               const p256_masked_scalar_t *private_key,
+                               ecdsa_p256_signature_t *signatures);
+
 /**
  * Start an async ECDSA/P-256 signature verification operation on OTBN.
  *
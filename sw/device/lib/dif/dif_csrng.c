@@ -4,6 +4,8 @@
 
 #include "sw/device/lib/dif/dif_csrng.h"
 
+#include <assert.h>
+
 #include "sw/device/lib/base/bitfield.h"
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
@@ -127,6 +129,73 @@ dif_result_t dif_csrng_generate_read(const dif_csrng_t *csrng, uint32_t *buf,
   return kDifOk;
 }
 
+/**
+ * Waits for the command interface to acknowledge the previous command.
+ *
+ * @return `kDifError` if the previous command failed.
+ */
+static dif_result_t wait_cmd_ready(const dif_csrng_t *csrng) {
+  uint32_t reg;
+  do {
+    reg = mmio_region_read32(csrng->base_addr, CSRNG_SW_CMD_STS_REG_OFFSET);
+  } while (!bitfield_bit32_read(reg, CSRNG_SW_CMD_STS_CMD_RDY_BIT));
+  if (bitfield_bit32_read(reg, CSRNG_SW_CMD_STS_CMD_STS_BIT)) {
+    return kDifError;
+  }
+  return kDifOk;
+}
+
+static_assert(kCsrngGenBitsBufferSize == 4,
+              "dif_csrng_generate_bulk() reads blocks of four words.");
+
+dif_result_t dif_csrng_generate_bulk(const dif_csrng_t *csrng, uint32_t *buf,
+                                     size_t len) {
+  if (csrng == NULL || buf == NULL || len == 0) {
+    return kDifBadArg;
+  }
+
+  size_t num_128bit_blocks =
+      (len + kCsrngGenBitsBufferSize - 1) / kCsrngGenBitsBufferSize;
+  while (num_128bit_blocks > 0) {
+    uint32_t cmd_blocks = num_128bit_blocks < kDifCsrngGenerateMaxBlocks
+                              ? (uint32_t)num_128bit_blocks
+                              : kDifCsrngGenerateMaxBlocks;
+    DIF_RETURN_IF_ERROR(wait_cmd_ready(csrng));
+    DIF_RETURN_IF_ERROR(
+        csrng_send_app_cmd(csrng->base_addr, CSRNG_CMD_REQ_REG_OFFSET,
+                           (csrng_app_cmd_t){
+                               .id = kCsrngAppCmdGenerate,
+                               .generate_len = cmd_blocks,
+                           }));
+    num_128bit_blocks -= cmd_blocks;
+
+    // Drain the output one 128-bit block at a time. The whole final block has
+    // to be read for the command to complete.
+    for (; cmd_blocks > 0; --cmd_blocks) {
+      spin_until_ready(csrng);
+      if (len >= kCsrngGenBitsBufferSize) {
+        buf[0] = mmio_region_read32(csrng->base_addr, CSRNG_GENBITS_REG_OFFSET);
+        buf[1] = mmio_region_read32(csrng->base_addr, CSRNG_GENBITS_REG_OFFSET);
+        buf[2] = mmio_region_read32(csrng->base_addr, CSRNG_GENBITS_REG_OFFSET);
+        buf[3] = mmio_region_read32(csrng->base_addr, CSRNG_GENBITS_REG_OFFSET);
+        buf += kCsrngGenBitsBufferSize;
+        len -= kCsrngGenBitsBufferSize;
+      } else {
+        for (size_t i = 0; i < kCsrngGenBitsBufferSize; ++i) {
+          uint32_t word =
+              mmio_region_read32(csrng->base_addr, CSRNG_GENBITS_REG_OFFSET);
+          if (i < len) {
+            buf[i] = word;
+          }
+        }
+        len = 0;
+      }
+    }
+  }
+  // The last command is acknowledged once all of its output has been read.
+  return wait_cmd_ready(csrng);
+}
+
 dif_result_t dif_csrng_uninstantiate(const dif_csrng_t *csrng) {
   if (csrng == NULL) {
     return kDifBadArg;
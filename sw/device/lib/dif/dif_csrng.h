@@ -44,7 +44,7 @@ extern "C" {
  * - `dif_csrng_init()`
  * - `dif_csrng_configure()`
  * - `dif_csrng_instantiate()`
- * - `dif_csrng_generate_start()`
+ * - `dif_csrng_generate_start()` or `dif_csrng_generate_bulk()`
  * - `dif_csrng_uninstantiate()`
  *
  * The following functions can be used for reseed and update operations:
@@ -67,6 +67,16 @@ extern "C" {
  * - Add internal state control and debug interface.
  */
 
+enum {
+  /**
+   * Maximum number of 128-bit blocks requested by a single generate command.
+   *
+   * This corresponds to the `max_number_of_bits_per_request` limit of 2^19
+   * bits in NIST SP 800-90Ar1 table 3.
+   */
+  kDifCsrngGenerateMaxBlocks = (1 << 19) / 128,
+};
+
 /**
  * Enumeration of CSRNG command interface states.
  */
@@ -405,6 +415,30 @@ OT_WARN_UNUSED_RESULT
 dif_result_t dif_csrng_generate_read(const dif_csrng_t *csrng, uint32_t *buf,
                                      size_t len);
 
+/**
+ * Generates `len` words of cryptographic entropy bits into `buf`.
+ *
+ * Unlike the `dif_csrng_generate_start()` / `dif_csrng_generate_read()` pair,
+ * this function takes care of requests of any size: it splits the request
+ * into generate commands of up to `kDifCsrngGenerateMaxBlocks` 128-bit blocks,
+ * issues each command as soon as the previous one has been acknowledged, and
+ * checks `GENBITS_VLD` once per 128-bit block. Excess words of the final
+ * block are drained and discarded. The function returns once the final
+ * command has been acknowledged.
+ *
+ * As with `dif_csrng_generate_start()`, it is the responsibility of the caller
+ * to reseed as needed.
+ *
+ * @param csrng A CSRNG handle.
+ * @param[out] buf A buffer to fill with words from the pipeline.
+ * @param len The number of words to generate.
+ * @return The result of the operation, `kDifError` if a generate command
+ * failed.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_csrng_generate_bulk(const dif_csrng_t *csrng, uint32_t *buf,
+                                     size_t len);
+
 /**
  * Uninstantiates CSRNG
  *
@@ -336,6 +336,70 @@ TEST_F(GenerateEndTest, ReadBadArgs) {
   EXPECT_DIF_BADARG(dif_csrng_generate_read(nullptr, &data, /*len=*/1));
 }
 
+class GenerateBulkTest : public DifCsrngTest {
+ protected:
+  void ExpectCmdReady() {
+    EXPECT_READ32(CSRNG_SW_CMD_STS_REG_OFFSET,
+                  {{CSRNG_SW_CMD_STS_CMD_RDY_BIT, true}});
+  }
+
+  void ExpectBlock(uint32_t first) {
+    EXPECT_READ32(CSRNG_GENBITS_VLD_REG_OFFSET,
+                  {{CSRNG_GENBITS_VLD_GENBITS_VLD_BIT, true}});
+    for (uint32_t i = 0; i < 4; ++i) {
+      EXPECT_READ32(CSRNG_GENBITS_REG_OFFSET, first + i);
+    }
+  }
+};
+
+TEST_F(GenerateBulkTest, PartialBlock) {
+  ExpectCmdReady();
+  EXPECT_WRITE32(CSRNG_CMD_REQ_REG_OFFSET,
+                 0x00002003 | kMultiBitBool4False << 8);
+  ExpectBlock(0x10);
+  EXPECT_READ32(CSRNG_GENBITS_VLD_REG_OFFSET, 0);
+  ExpectBlock(0x20);
+  EXPECT_READ32(CSRNG_SW_CMD_STS_REG_OFFSET, 0);
+  ExpectCmdReady();
+
+  // The surplus words of the last block are read but discarded.
+  std::vector<uint32_t> got(7, 0xffffffff);
+  EXPECT_DIF_OK(dif_csrng_generate_bulk(&csrng_, got.data(), 6));
+  EXPECT_THAT(got, testing::ElementsAre(0x10, 0x11, 0x12, 0x13, 0x20, 0x21,
+                                        0xffffffff));
+}
+
+TEST_F(GenerateBulkTest, CmdError) {
+  uint32_t data[4];
+  EXPECT_READ32(CSRNG_SW_CMD_STS_REG_OFFSET,
+                {
+                    {CSRNG_SW_CMD_STS_CMD_RDY_BIT, true},
+                    {CSRNG_SW_CMD_STS_CMD_STS_BIT, true},
+                });
+  EXPECT_EQ(dif_csrng_generate_bulk(&csrng_, data, 4), kDifError);
+}
+
+TEST_F(GenerateBulkTest, LastCmdError) {
+  uint32_t data[4];
+  ExpectCmdReady();
+  EXPECT_WRITE32(CSRNG_CMD_REQ_REG_OFFSET,
+                 0x00001003 | kMultiBitBool4False << 8);
+  ExpectBlock(0x10);
+  EXPECT_READ32(CSRNG_SW_CMD_STS_REG_OFFSET,
+                {
+                    {CSRNG_SW_CMD_STS_CMD_RDY_BIT, true},
+                    {CSRNG_SW_CMD_STS_CMD_STS_BIT, true},
+                });
+  EXPECT_EQ(dif_csrng_generate_bulk(&csrng_, data, 4), kDifError);
+}
+
+TEST_F(GenerateBulkTest, BadArgs) {
+  uint32_t data;
+  EXPECT_DIF_BADARG(dif_csrng_generate_bulk(nullptr, &data, 1));
+  EXPECT_DIF_BADARG(dif_csrng_generate_bulk(&csrng_, nullptr, 1));
+  EXPECT_DIF_BADARG(dif_csrng_generate_bulk(&csrng_, &data, 0));
+}
+
 class GetInternalStateTest : public DifCsrngTest {};
 
 TEST_F(GetInternalStateTest, GetInternalStateOk) {
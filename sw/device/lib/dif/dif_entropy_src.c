@@ -511,6 +511,54 @@ dif_result_t dif_entropy_src_observe_fifo_blocking_read(
   return kDifOk;
 }
 
+dif_result_t dif_entropy_src_observe_fifo_read_stream(
+    const dif_entropy_src_t *entropy_src, uint32_t *buf, size_t len,
+    size_t *read) {
+  if (entropy_src == NULL || (buf == NULL && len > 0) || read == NULL) {
+    return kDifBadArg;
+  }
+
+  // We can only read from the override FIFO in firmware override mode.
+  uint32_t reg = mmio_region_read32(entropy_src->base_addr,
+                                    ENTROPY_SRC_FW_OV_CONTROL_REG_OFFSET);
+  if (bitfield_field32_read(reg, ENTROPY_SRC_FW_OV_CONTROL_FW_OV_MODE_FIELD) !=
+      kMultiBitBool4True) {
+    return kDifError;
+  }
+
+  *read = 0;
+  while (*read < len) {
+    // Everything the depth register reports can be popped without looking at
+    // the status again, since nothing else drains the FIFO.
+    reg = mmio_region_read32(entropy_src->base_addr,
+                             ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET);
+    size_t burst = bitfield_field32_read(
+        reg, ENTROPY_SRC_OBSERVE_FIFO_DEPTH_OBSERVE_FIFO_DEPTH_FIELD);
+    if (burst == 0) {
+      break;
+    }
+    if (burst > len - *read) {
+      burst = len - *read;
+    }
+
+    for (size_t i = 0; i < burst; ++i) {
+      buf[*read + i] = mmio_region_read32(entropy_src->base_addr,
+                                          ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET);
+    }
+    *read += burst;
+  }
+
+  // The interrupt sets again if the FIFO refills past its threshold.
+  if (*read != 0) {
+    reg = bitfield_bit32_write(
+        0, ENTROPY_SRC_INTR_STATE_ES_OBSERVE_FIFO_READY_BIT, true);
+    mmio_region_write32(entropy_src->base_addr,
+                        ENTROPY_SRC_INTR_STATE_REG_OFFSET, reg);
+  }
+
+  return kDifOk;
+}
+
 dif_result_t dif_entropy_src_observe_fifo_write(
     const dif_entropy_src_t *entropy_src, const uint32_t *buf, size_t len,
     size_t *written) {
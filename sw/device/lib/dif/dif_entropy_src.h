@@ -640,6 +640,29 @@ OT_WARN_UNUSED_RESULT
 dif_result_t dif_entropy_src_observe_fifo_blocking_read(
     const dif_entropy_src_t *entropy_src, uint32_t *buf, size_t len);
 
+/**
+ * Streams words from the observe FIFO into `buf` without blocking.
+ *
+ * Unlike `dif_entropy_src_observe_fifo_blocking_read()`, this function reads
+ * the observe FIFO depth once per burst and then drains that many words
+ * without checking the status again. It keeps going until `len` words have
+ * been read or the FIFO is empty, so large captures can be chained into a
+ * single host-exportable buffer by calling it repeatedly with `buf + *read`.
+ *
+ * The entropy source must be configured with firmware override mode enabled,
+ * otherwise the function will return `kDifError`.
+ *
+ * @param entropy_src An entropy source handle.
+ * @param[out] buf A buffer to fill with words from the pipeline.
+ * @param len The maximum number of words to read into `buf`.
+ * @param[out] read The number of words read.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_entropy_src_observe_fifo_read_stream(
+    const dif_entropy_src_t *entropy_src, uint32_t *buf, size_t len,
+    size_t *read);
+
 /**
  * Performs a write to the entropy pipeline through the observe FIFO.
  *
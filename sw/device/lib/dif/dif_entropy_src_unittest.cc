@@ -4,6 +4,8 @@
 
 #include "sw/device/lib/dif/dif_entropy_src.h"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/base/mock_mmio.h"
@@ -15,6 +17,7 @@
 
 namespace dif_entropy_src_unittest {
 namespace {
+using ::testing::ElementsAre;
 
 class EntropySrcTest : public testing::Test, public mock_mmio::MmioTest {
  protected:
@@ -566,6 +569,86 @@ TEST_F(ObserveFifoBlockingReadTest, SuccessDataSave) {
   }
 }
 
+class ObserveFifoReadStreamTest : public EntropySrcTest {
+ protected:
+  void ExpectFwOverride(bool enabled) {
+    EXPECT_READ32(ENTROPY_SRC_FW_OV_CONTROL_REG_OFFSET,
+                  {{ENTROPY_SRC_FW_OV_CONTROL_FW_OV_MODE_OFFSET,
+                    enabled ? kMultiBitBool4True : kMultiBitBool4False}});
+  }
+
+  void ExpectBurst(const std::vector<uint32_t> &words) {
+    EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET, words.size());
+    for (uint32_t word : words) {
+      EXPECT_READ32(ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET, word);
+    }
+  }
+
+  void ExpectIrqClear() {
+    EXPECT_WRITE32(ENTROPY_SRC_INTR_STATE_REG_OFFSET,
+                   {{ENTROPY_SRC_INTR_STATE_ES_OBSERVE_FIFO_READY_BIT, 1}});
+  }
+};
+
+TEST_F(ObserveFifoReadStreamTest, NullArgs) {
+  uint32_t buf[4];
+  size_t read;
+  EXPECT_DIF_BADARG(dif_entropy_src_observe_fifo_read_stream(
+      nullptr, buf, 4, &read));
+  EXPECT_DIF_BADARG(dif_entropy_src_observe_fifo_read_stream(
+      &entropy_src_, buf, 4, nullptr));
+  EXPECT_DIF_BADARG(dif_entropy_src_observe_fifo_read_stream(
+      &entropy_src_, nullptr, 4, &read));
+}
+
+TEST_F(ObserveFifoReadStreamTest, BadConfig) {
+  uint32_t buf[4];
+  size_t read;
+  ExpectFwOverride(false);
+  EXPECT_EQ(dif_entropy_src_observe_fifo_read_stream(&entropy_src_, buf, 4,
+                                                     &read),
+            kDifError);
+}
+
+TEST_F(ObserveFifoReadStreamTest, Empty) {
+  uint32_t buf[4];
+  size_t read;
+  ExpectFwOverride(true);
+  EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET, 0);
+  EXPECT_DIF_OK(dif_entropy_src_observe_fifo_read_stream(&entropy_src_, buf, 4,
+                                                         &read));
+  EXPECT_EQ(read, 0);
+}
+
+TEST_F(ObserveFifoReadStreamTest, DrainsBursts) {
+  uint32_t buf[6] = {0};
+  size_t read;
+  ExpectFwOverride(true);
+  ExpectBurst({1, 2, 3});
+  ExpectBurst({4, 5});
+  EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET, 0);
+  ExpectIrqClear();
+  EXPECT_DIF_OK(dif_entropy_src_observe_fifo_read_stream(&entropy_src_, buf, 6,
+                                                         &read));
+  EXPECT_EQ(read, 5);
+  EXPECT_THAT(buf, ElementsAre(1, 2, 3, 4, 5, 0));
+}
+
+TEST_F(ObserveFifoReadStreamTest, StopsAtLength) {
+  uint32_t buf[3];
+  size_t read;
+  ExpectFwOverride(true);
+  EXPECT_READ32(ENTROPY_SRC_OBSERVE_FIFO_DEPTH_REG_OFFSET, 8);
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_READ32(ENTROPY_SRC_FW_OV_RD_DATA_REG_OFFSET, i);
+  }
+  ExpectIrqClear();
+  EXPECT_DIF_OK(dif_entropy_src_observe_fifo_read_stream(&entropy_src_, buf, 3,
+                                                         &read));
+  EXPECT_EQ(read, 3);
+  EXPECT_THAT(buf, ElementsAre(0, 1, 2));
+}
+
 class ObserveFifoWriteTest : public EntropySrcTest {};
 
 TEST_F(ObserveFifoWriteTest, NullArgs) {
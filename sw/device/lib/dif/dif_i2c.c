@@ -555,6 +555,108 @@ dif_result_t dif_i2c_acquire_byte(const dif_i2c_t *i2c, uint8_t *byte,
   return kDifOk;
 }
 
+/**
+ * Returns the number of free entries in a FIFO with `level` entries in use.
+ */
+static size_t fifo_space(uint32_t level) {
+  return level < I2C_PARAM_FIFO_DEPTH ? I2C_PARAM_FIFO_DEPTH - level : 0;
+}
+
+dif_result_t dif_i2c_write_bytes(const dif_i2c_t *i2c, const uint8_t *data,
+                                 size_t len, bool stop, size_t *written) {
+  if (i2c == NULL || (data == NULL && len > 0) || written == NULL) {
+    return kDifBadArg;
+  }
+
+  uint32_t levels =
+      mmio_region_read32(i2c->base_addr, I2C_FIFO_STATUS_REG_OFFSET);
+  size_t count =
+      fifo_space(bitfield_field32_read(levels, I2C_FIFO_STATUS_FMTLVL_FIELD));
+  if (count > len) {
+    count = len;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    bool last = i == len - 1;
+    uint32_t fmt_byte =
+        bitfield_field32_write(0, I2C_FDATA_FBYTE_FIELD, data[i]);
+    fmt_byte = bitfield_bit32_write(fmt_byte, I2C_FDATA_STOP_BIT, stop && last);
+    mmio_region_write32(i2c->base_addr, I2C_FDATA_REG_OFFSET, fmt_byte);
+  }
+  *written = count;
+
+  return kDifOk;
+}
+
+dif_result_t dif_i2c_read_bytes(const dif_i2c_t *i2c, uint8_t *data,
+                                size_t len, size_t *read) {
+  if (i2c == NULL || (data == NULL && len > 0) || read == NULL) {
+    return kDifBadArg;
+  }
+
+  uint32_t levels =
+      mmio_region_read32(i2c->base_addr, I2C_FIFO_STATUS_REG_OFFSET);
+  size_t count = bitfield_field32_read(levels, I2C_FIFO_STATUS_RXLVL_FIELD);
+  if (count > len) {
+    count = len;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t values = mmio_region_read32(i2c->base_addr, I2C_RDATA_REG_OFFSET);
+    data[i] = bitfield_field32_read(values, I2C_RDATA_RDATA_FIELD);
+  }
+  *read = count;
+
+  return kDifOk;
+}
+
+dif_result_t dif_i2c_transmit_bytes(const dif_i2c_t *i2c, const uint8_t *data,
+                                    size_t len, size_t *written) {
+  if (i2c == NULL || (data == NULL && len > 0) || written == NULL) {
+    return kDifBadArg;
+  }
+
+  uint32_t levels =
+      mmio_region_read32(i2c->base_addr, I2C_FIFO_STATUS_REG_OFFSET);
+  size_t count =
+      fifo_space(bitfield_field32_read(levels, I2C_FIFO_STATUS_TXLVL_FIELD));
+  if (count > len) {
+    count = len;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    mmio_region_write32(
+        i2c->base_addr, I2C_TXDATA_REG_OFFSET,
+        bitfield_field32_write(0, I2C_TXDATA_TXDATA_FIELD, data[i]));
+  }
+  *written = count;
+
+  return kDifOk;
+}
+
+dif_result_t dif_i2c_acquire_bytes(const dif_i2c_t *i2c, uint8_t *data,
+                                   dif_i2c_signal_t *signals, size_t len,
+                                   size_t *read) {
+  if (i2c == NULL || (data == NULL && len > 0) || read == NULL) {
+    return kDifBadArg;
+  }
+
+  uint32_t levels =
+      mmio_region_read32(i2c->base_addr, I2C_FIFO_STATUS_REG_OFFSET);
+  size_t count = bitfield_field32_read(levels, I2C_FIFO_STATUS_ACQLVL_FIELD);
+  if (count > len) {
+    count = len;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t acq_byte =
+        mmio_region_read32(i2c->base_addr, I2C_ACQDATA_REG_OFFSET);
+    data[i] = bitfield_field32_read(acq_byte, I2C_ACQDATA_ABYTE_FIELD);
+    if (signals != NULL) {
+      signals[i] = bitfield_field32_read(acq_byte, I2C_ACQDATA_SIGNAL_FIELD);
+    }
+  }
+  *read = count;
+
+  return kDifOk;
+}
+
 dif_result_t dif_i2c_enable_clock_stretching_timeout(const dif_i2c_t *i2c,
                                                      dif_toggle_t enable,
                                                      uint32_t cycles) {
@@ -626,6 +626,76 @@ OT_WARN_UNUSED_RESULT
 dif_result_t dif_i2c_acquire_byte(const dif_i2c_t *i2c, uint8_t *byte,
                                   dif_i2c_signal_t *signal);
 
+/**
+ * Pushes as many bytes as fit onto the FMT FIFO as plain transmit entries.
+ *
+ * The FIFO level is read once, after which up to the free number of entries
+ * are written back to back. Call again with the remainder of the buffer, e.g.
+ * from the `kDifI2cIrqFmtThreshold` interrupt, until all bytes are written.
+ *
+ * @param i2c An I2C handle.
+ * @param data The bytes to transmit.
+ * @param len The number of bytes in `data`.
+ * @param stop Whether to send a stop signal after the last byte of `data`.
+ * @param[out] written The number of bytes pushed onto the FIFO.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_i2c_write_bytes(const dif_i2c_t *i2c, const uint8_t *data,
+                                 size_t len, bool stop, size_t *written);
+
+/**
+ * Pops as many bytes as are available, up to `len`, off of the RX FIFO.
+ *
+ * The FIFO level is read once, after which the available entries are read
+ * back to back.
+ *
+ * @param i2c An I2C handle.
+ * @param[out] data Buffer for the popped bytes.
+ * @param len The size of `data`.
+ * @param[out] read The number of bytes popped.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_i2c_read_bytes(const dif_i2c_t *i2c, uint8_t *data,
+                                size_t len, size_t *read);
+
+/**
+ * Pushes as many bytes as fit into the TX FIFO to make them available when
+ * this I2C block responds to an I2C Read as a target device.
+ *
+ * The FIFO level is read once, after which up to the free number of entries
+ * are written back to back.
+ *
+ * @param i2c An I2C handle.
+ * @param data The bytes to transmit.
+ * @param len The number of bytes in `data`.
+ * @param[out] written The number of bytes pushed into the FIFO.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_i2c_transmit_bytes(const dif_i2c_t *i2c, const uint8_t *data,
+                                    size_t len, size_t *written);
+
+/**
+ * Pops as many entries as are available, up to `len`, off of the ACQ FIFO.
+ *
+ * The FIFO level is read once, after which the available entries are read
+ * back to back.
+ *
+ * @param i2c An I2C handle.
+ * @param[out] data Buffer for the acquired bytes.
+ * @param[out] signals Buffer for the signal of each acquired byte; may be
+ * `NULL`.
+ * @param len The size of `data` and `signals`.
+ * @param[out] read The number of entries popped.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_i2c_acquire_bytes(const dif_i2c_t *i2c, uint8_t *data,
+                                   dif_i2c_signal_t *signals, size_t len,
+                                   size_t *read);
+
 /**
  * Enables clock stretching timeout after a number of I2C block clock cycles
  * when I2C block is configured as host.
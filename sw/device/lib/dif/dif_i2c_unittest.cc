@@ -84,6 +84,7 @@ namespace {
 using ::mock_mmio::LeInt;
 using ::mock_mmio::MmioTest;
 using ::mock_mmio::MockDevice;
+using ::testing::ElementsAre;
 
 class I2cTest : public testing::Test, public MmioTest {
  protected:
@@ -726,6 +727,112 @@ TEST_F(FifoTest, TransmitBadArgs) {
   EXPECT_DIF_BADARG(dif_i2c_transmit_byte(nullptr, 0xff));
 }
 
+TEST_F(FifoTest, WriteBytes) {
+  const uint8_t data[] = {0x11, 0x22, 0x33};
+  size_t written;
+
+  // The last byte carries the stop.
+  EXPECT_READ32(I2C_FIFO_STATUS_REG_OFFSET,
+                {{I2C_FIFO_STATUS_FMTLVL_OFFSET, 1}});
+  EXPECT_WRITE32(I2C_FDATA_REG_OFFSET, {{I2C_FDATA_FBYTE_OFFSET, 0x11}});
+  EXPECT_WRITE32(I2C_FDATA_REG_OFFSET, {{I2C_FDATA_FBYTE_OFFSET, 0x22}});
+  EXPECT_WRITE32(I2C_FDATA_REG_OFFSET, {
+                                           {I2C_FDATA_FBYTE_OFFSET, 0x33},
+                                           {I2C_FDATA_STOP_BIT, 0x1},
+                                       });
+  EXPECT_DIF_OK(dif_i2c_write_bytes(&i2c_, data, sizeof(data), true, &written));
+  EXPECT_EQ(written, 3);
+
+  // Only the free entries are filled, so no stop is sent yet.
+  EXPECT_READ32(I2C_FIFO_STATUS_REG_OFFSET,
+                {{I2C_FIFO_STATUS_FMTLVL_OFFSET, I2C_PARAM_FIFO_DEPTH - 2}});
+  EXPECT_WRITE32(I2C_FDATA_REG_OFFSET, {{I2C_FDATA_FBYTE_OFFSET, 0x11}});
+  EXPECT_WRITE32(I2C_FDATA_REG_OFFSET, {{I2C_FDATA_FBYTE_OFFSET, 0x22}});
+  EXPECT_DIF_OK(dif_i2c_write_bytes(&i2c_, data, sizeof(data), true, &written));
+  EXPECT_EQ(written, 2);
+
+  EXPECT_READ32(I2C_FIFO_STATUS_REG_OFFSET,
+                {{I2C_FIFO_STATUS_FMTLVL_OFFSET, I2C_PARAM_FIFO_DEPTH}});
+  EXPECT_DIF_OK(dif_i2c_write_bytes(&i2c_, data, sizeof(data), true, &written));
+  EXPECT_EQ(written, 0);
+}
+
+TEST_F(FifoTest, ReadBytes) {
+  uint8_t data[4] = {0};
+  size_t read;
+
+  EXPECT_READ32(I2C_FIFO_STATUS_REG_OFFSET,
+                {{I2C_FIFO_STATUS_RXLVL_OFFSET, 2}});
+  EXPECT_READ32(I2C_RDATA_REG_OFFSET, 0xab);
+  EXPECT_READ32(I2C_RDATA_REG_OFFSET, 0xcd);
+  EXPECT_DIF_OK(dif_i2c_read_bytes(&i2c_, data, sizeof(data), &read));
+  EXPECT_EQ(read, 2);
+  EXPECT_THAT(data, ElementsAre(0xab, 0xcd, 0, 0));
+
+  EXPECT_READ32(I2C_FIFO_STATUS_REG_OFFSET,
+                {{I2C_FIFO_STATUS_RXLVL_OFFSET, 10}});
+  EXPECT_READ32(I2C_RDATA_REG_OFFSET, 0x01);
+  EXPECT_DIF_OK(dif_i2c_read_bytes(&i2c_, data, 1, &read));
+  EXPECT_EQ(read, 1);
+  EXPECT_THAT(data, ElementsAre(0x01, 0xcd, 0, 0));
+}
+
+TEST_F(FifoTest, TransmitBytes) {
+  const uint8_t data[] = {0x44, 0x55, 0x66};
+  size_t written;
+
+  EXPECT_READ32(I2C_FIFO_STATUS_REG_OFFSET,
+                {{I2C_FIFO_STATUS_TXLVL_OFFSET, I2C_PARAM_FIFO_DEPTH - 2}});
+  EXPECT_WRITE32(I2C_TXDATA_REG_OFFSET, 0x44);
+  EXPECT_WRITE32(I2C_TXDATA_REG_OFFSET, 0x55);
+  EXPECT_DIF_OK(dif_i2c_transmit_bytes(&i2c_, data, sizeof(data), &written));
+  EXPECT_EQ(written, 2);
+}
+
+TEST_F(FifoTest, AcquireBytes) {
+  uint8_t data[3] = {0};
+  dif_i2c_signal_t signals[3];
+  size_t read;
+
+  EXPECT_READ32(I2C_FIFO_STATUS_REG_OFFSET,
+                {{I2C_FIFO_STATUS_ACQLVL_OFFSET, 3}});
+  EXPECT_READ32(I2C_ACQDATA_REG_OFFSET, 0x1a0);
+  EXPECT_READ32(I2C_ACQDATA_REG_OFFSET, 0x0cd);
+  EXPECT_READ32(I2C_ACQDATA_REG_OFFSET, 0x2ef);
+  EXPECT_DIF_OK(
+      dif_i2c_acquire_bytes(&i2c_, data, signals, sizeof(data), &read));
+  EXPECT_EQ(read, 3);
+  EXPECT_THAT(data, ElementsAre(0xa0, 0xcd, 0xef));
+  EXPECT_THAT(signals, ElementsAre(kDifI2cSignalStart, kDifI2cSignalNone,
+                                   kDifI2cSignalStop));
+
+  EXPECT_READ32(I2C_FIFO_STATUS_REG_OFFSET,
+                {{I2C_FIFO_STATUS_ACQLVL_OFFSET, 1}});
+  EXPECT_READ32(I2C_ACQDATA_REG_OFFSET, 0x012);
+  EXPECT_DIF_OK(
+      dif_i2c_acquire_bytes(&i2c_, data, nullptr, sizeof(data), &read));
+  EXPECT_EQ(read, 1);
+  EXPECT_EQ(data[0], 0x12);
+}
+
+TEST_F(FifoTest, BytesNullArgs) {
+  uint8_t data[1];
+  size_t count;
+
+  EXPECT_DIF_BADARG(dif_i2c_write_bytes(nullptr, data, 1, false, &count));
+  EXPECT_DIF_BADARG(dif_i2c_write_bytes(&i2c_, nullptr, 1, false, &count));
+  EXPECT_DIF_BADARG(dif_i2c_write_bytes(&i2c_, data, 1, false, nullptr));
+  EXPECT_DIF_BADARG(dif_i2c_read_bytes(nullptr, data, 1, &count));
+  EXPECT_DIF_BADARG(dif_i2c_read_bytes(&i2c_, nullptr, 1, &count));
+  EXPECT_DIF_BADARG(dif_i2c_read_bytes(&i2c_, data, 1, nullptr));
+  EXPECT_DIF_BADARG(dif_i2c_transmit_bytes(nullptr, data, 1, &count));
+  EXPECT_DIF_BADARG(dif_i2c_transmit_bytes(&i2c_, nullptr, 1, &count));
+  EXPECT_DIF_BADARG(dif_i2c_transmit_bytes(&i2c_, data, 1, nullptr));
+  EXPECT_DIF_BADARG(dif_i2c_acquire_bytes(nullptr, data, nullptr, 1, &count));
+  EXPECT_DIF_BADARG(dif_i2c_acquire_bytes(&i2c_, nullptr, nullptr, 1, &count));
+  EXPECT_DIF_BADARG(dif_i2c_acquire_bytes(&i2c_, data, nullptr, 1, nullptr));
+}
+
 class StretchTest : public I2cTest {};
 
 TEST_F(StretchTest, ConfigTimeouts) {
@@ -759,3 +759,76 @@ dif_result_t dif_otp_ctrl_read_blocking(const dif_otp_ctrl_t *otp,
                                  len * sizeof(uint32_t));
   return kDifOk;
 }
+
+/**
+ * Busy-waits until the Direct Access Interface is idle.
+ *
+ * Polls the STATUS register directly to keep the loop short.
+ *
+ * @param otp An OTP handle.
+ * @return `kDifError` if the last operation failed, `kDifOk` otherwise.
+ */
+static dif_result_t dai_wait_idle(const dif_otp_ctrl_t *otp) {
+  uint32_t status;
+  do {
+    status = mmio_region_read32(otp->base_addr, OTP_CTRL_STATUS_REG_OFFSET);
+  } while (!bitfield_bit32_read(status, OTP_CTRL_STATUS_DAI_IDLE_BIT));
+
+  if (bitfield_bit32_read(status, OTP_CTRL_STATUS_DAI_ERROR_BIT)) {
+    return kDifError;
+  }
+  return kDifOk;
+}
+
+dif_result_t dif_otp_ctrl_read_range_blocking(
+    const dif_otp_ctrl_t *otp, dif_otp_ctrl_partition_t partition,
+    uint32_t address, uint32_t *buf, size_t len) {
+  if (otp == NULL || partition >= ARRAYSIZE(kPartitions) || buf == NULL) {
+    return kDifBadArg;
+  }
+
+  const partition_info_t *info = &kPartitions[partition];
+  if ((address & info->align_mask) != 0 ||
+      ((len * sizeof(uint32_t)) & info->align_mask) != 0) {
+    return kDifUnaligned;
+  }
+
+  if (address > info->len || len > (info->len - address) / sizeof(uint32_t)) {
+    return kDifOutOfRange;
+  }
+
+  address += info->start_addr;
+  if (info->is_software) {
+    mmio_region_memcpy_from_mmio32(
+        otp->base_addr, OTP_CTRL_SW_CFG_WINDOW_REG_OFFSET + address, buf,
+        len * sizeof(uint32_t));
+    return kDifOk;
+  }
+
+  uint32_t busy = mmio_region_read32(otp->base_addr,
+                                     OTP_CTRL_DIRECT_ACCESS_REGWEN_REG_OFFSET);
+  if (!bitfield_bit32_read(
+          busy, OTP_CTRL_DIRECT_ACCESS_REGWEN_DIRECT_ACCESS_REGWEN_BIT)) {
+    return kDifUnavailable;
+  }
+
+  uint32_t cmd =
+      bitfield_bit32_write(0, OTP_CTRL_DIRECT_ACCESS_CMD_RD_BIT, true);
+  size_t words_per_read = (info->align_mask + 1) / sizeof(uint32_t);
+  for (size_t i = 0; i < len; i += words_per_read) {
+    mmio_region_write32(otp->base_addr,
+                        OTP_CTRL_DIRECT_ACCESS_ADDRESS_REG_OFFSET,
+                        address + i * sizeof(uint32_t));
+    mmio_region_write32(otp->base_addr, OTP_CTRL_DIRECT_ACCESS_CMD_REG_OFFSET,
+                        cmd);
+    DIF_RETURN_IF_ERROR(dai_wait_idle(otp));
+    buf[i] = mmio_region_read32(otp->base_addr,
+                                OTP_CTRL_DIRECT_ACCESS_RDATA_0_REG_OFFSET);
+    if (words_per_read == 2) {
+      buf[i + 1] = mmio_region_read32(
+          otp->base_addr, OTP_CTRL_DIRECT_ACCESS_RDATA_1_REG_OFFSET);
+    }
+  }
+
+  return kDifOk;
+}
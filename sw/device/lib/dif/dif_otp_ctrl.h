@@ -604,6 +604,35 @@ dif_result_t dif_otp_ctrl_read_blocking(const dif_otp_ctrl_t *otp,
                                         uint32_t address, uint32_t *buf,
                                         size_t len);
 
+/**
+ * Reads a range of words from the given partition.
+ *
+ * This function reads `len` 32-bit words, starting at `address`, relative to
+ * the start of `partition`. Software partitions are read through the
+ * memory-mapped window. All other partitions are read through the Direct
+ * Access Interface, issuing the next command as soon as the previous one
+ * completes. For secret partitions, each 64-bit word is stored in two
+ * consecutive elements of `buf`, least significant word first, and `len` must
+ * be even.
+ *
+ * The same caveats for `dif_otp_ctrl_dai_read_start()` apply to `address`; in
+ * addition, the range must be within `partition`.
+ *
+ * This function will block until all reads complete.
+ *
+ * @param otp An OTP handle.
+ * @param partition The partition to read from.
+ * @param address A partition-relative address to read from.
+ * @param[out] buf A buffer of words to write read values to.
+ * @param len The number of 32-bit words to read.
+ * @return The result of the operation; `kDifUnavailable` if the Direct Access
+ * Interface is busy, `kDifError` if one of its operations fails.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_otp_ctrl_read_range_blocking(
+    const dif_otp_ctrl_t *otp, dif_otp_ctrl_partition_t partition,
+    uint32_t address, uint32_t *buf, size_t len);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -678,5 +678,125 @@ TEST_F(BlockingIoTest, NullArgs) {
       &otp_, kDifOtpCtrlPartitionOwnerSwCfg, 0x10, nullptr, buf.size()));
 }
 
+class ReadRangeTest : public OtpTest {
+ protected:
+  /**
+   * Sets expectations for a DAI read that completes after one busy poll.
+   */
+  void ExpectDaiRead(uint32_t address, uint32_t rdata0) {
+    EXPECT_WRITE32(OTP_CTRL_DIRECT_ACCESS_ADDRESS_REG_OFFSET, address);
+    EXPECT_WRITE32(OTP_CTRL_DIRECT_ACCESS_CMD_REG_OFFSET,
+                   {{OTP_CTRL_DIRECT_ACCESS_CMD_RD_BIT, true}});
+    EXPECT_READ32(OTP_CTRL_STATUS_REG_OFFSET, 0);
+    EXPECT_READ32(OTP_CTRL_STATUS_REG_OFFSET,
+                  {{OTP_CTRL_STATUS_DAI_IDLE_BIT, true}});
+    EXPECT_READ32(OTP_CTRL_DIRECT_ACCESS_RDATA_0_REG_OFFSET, rdata0);
+  }
+
+  void ExpectDaiIdle(bool idle) {
+    EXPECT_READ32(
+        OTP_CTRL_DIRECT_ACCESS_REGWEN_REG_OFFSET,
+        {{OTP_CTRL_DIRECT_ACCESS_REGWEN_DIRECT_ACCESS_REGWEN_BIT, idle}});
+  }
+};
+
+TEST_F(ReadRangeTest, SoftwarePartition) {
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_READ32(OTP_CTRL_SW_CFG_WINDOW_REG_OFFSET +
+                      OTP_CTRL_PARAM_CREATOR_SW_CFG_OFFSET + 0x8 +
+                      i * sizeof(uint32_t),
+                  i + 1);
+  }
+
+  std::vector<uint32_t> buf(3);
+  EXPECT_DIF_OK(dif_otp_ctrl_read_range_blocking(
+      &otp_, kDifOtpCtrlPartitionCreatorSwCfg, 0x8, buf.data(), buf.size()));
+  EXPECT_THAT(buf, ElementsAre(1, 2, 3));
+}
+
+TEST_F(ReadRangeTest, HwCfg) {
+  ExpectDaiIdle(true);
+  ExpectDaiRead(OTP_CTRL_PARAM_HW_CFG_OFFSET + 0x4, 0x11111111);
+  ExpectDaiRead(OTP_CTRL_PARAM_HW_CFG_OFFSET + 0x8, 0x22222222);
+
+  std::vector<uint32_t> buf(2);
+  EXPECT_DIF_OK(dif_otp_ctrl_read_range_blocking(
+      &otp_, kDifOtpCtrlPartitionHwCfg, 0x4, buf.data(), buf.size()));
+  EXPECT_THAT(buf, ElementsAre(0x11111111, 0x22222222));
+}
+
+TEST_F(ReadRangeTest, Secret) {
+  ExpectDaiIdle(true);
+  ExpectDaiRead(OTP_CTRL_PARAM_SECRET1_OFFSET + 0x8, 0x33333333);
+  EXPECT_READ32(OTP_CTRL_DIRECT_ACCESS_RDATA_1_REG_OFFSET, 0x44444444);
+  ExpectDaiRead(OTP_CTRL_PARAM_SECRET1_OFFSET + 0x10, 0x55555555);
+  EXPECT_READ32(OTP_CTRL_DIRECT_ACCESS_RDATA_1_REG_OFFSET, 0x66666666);
+
+  std::vector<uint32_t> buf(4);
+  EXPECT_DIF_OK(dif_otp_ctrl_read_range_blocking(
+      &otp_, kDifOtpCtrlPartitionSecret1, 0x8, buf.data(), buf.size()));
+  EXPECT_THAT(buf, ElementsAre(0x33333333, 0x44444444, 0x55555555, 0x66666666));
+}
+
+TEST_F(ReadRangeTest, DaiError) {
+  ExpectDaiIdle(true);
+  EXPECT_WRITE32(OTP_CTRL_DIRECT_ACCESS_ADDRESS_REG_OFFSET,
+                 OTP_CTRL_PARAM_HW_CFG_OFFSET);
+  EXPECT_WRITE32(OTP_CTRL_DIRECT_ACCESS_CMD_REG_OFFSET,
+                 {{OTP_CTRL_DIRECT_ACCESS_CMD_RD_BIT, true}});
+  EXPECT_READ32(OTP_CTRL_STATUS_REG_OFFSET,
+                {
+                    {OTP_CTRL_STATUS_DAI_IDLE_BIT, true},
+                    {OTP_CTRL_STATUS_DAI_ERROR_BIT, true},
+                });
+
+  std::vector<uint32_t> buf(2);
+  EXPECT_EQ(dif_otp_ctrl_read_range_blocking(
+                &otp_, kDifOtpCtrlPartitionHwCfg, 0, buf.data(), buf.size()),
+            kDifError);
+}
+
+TEST_F(ReadRangeTest, Busy) {
+  ExpectDaiIdle(false);
+
+  std::vector<uint32_t> buf(2);
+  EXPECT_EQ(dif_otp_ctrl_read_range_blocking(
+                &otp_, kDifOtpCtrlPartitionHwCfg, 0, buf.data(), buf.size()),
+            kDifUnavailable);
+}
+
+TEST_F(ReadRangeTest, Unaligned) {
+  std::vector<uint32_t> buf(2);
+  EXPECT_EQ(dif_otp_ctrl_read_range_blocking(
+                &otp_, kDifOtpCtrlPartitionOwnerSwCfg, 0x2, buf.data(), 1),
+            kDifUnaligned);
+  EXPECT_EQ(dif_otp_ctrl_read_range_blocking(
+                &otp_, kDifOtpCtrlPartitionSecret0, 0x4, buf.data(), 2),
+            kDifUnaligned);
+  EXPECT_EQ(dif_otp_ctrl_read_range_blocking(
+                &otp_, kDifOtpCtrlPartitionSecret0, 0x8, buf.data(), 1),
+            kDifUnaligned);
+}
+
+TEST_F(ReadRangeTest, OutOfRange) {
+  std::vector<uint32_t> buf(2);
+  EXPECT_EQ(dif_otp_ctrl_read_range_blocking(
+                &otp_, kDifOtpCtrlPartitionOwnerSwCfg,
+                OTP_CTRL_PARAM_OWNER_SW_CFG_SIZE - 4, buf.data(), 2),
+            kDifOutOfRange);
+  EXPECT_EQ(dif_otp_ctrl_read_range_blocking(
+                &otp_, kDifOtpCtrlPartitionOwnerSwCfg,
+                OTP_CTRL_PARAM_OWNER_SW_CFG_SIZE + 4, buf.data(), 0),
+            kDifOutOfRange);
+}
+
+TEST_F(ReadRangeTest, NullArgs) {
+  std::vector<uint32_t> buf(2);
+  EXPECT_DIF_BADARG(dif_otp_ctrl_read_range_blocking(
+      nullptr, kDifOtpCtrlPartitionOwnerSwCfg, 0, buf.data(), buf.size()));
+  EXPECT_DIF_BADARG(dif_otp_ctrl_read_range_blocking(
+      &otp_, kDifOtpCtrlPartitionOwnerSwCfg, 0, nullptr, buf.size()));
+}
+
 }  // namespace
 }  // namespace dif_otp_ctrl_unittest
@@ -18,12 +18,12 @@
 // unit tests can provide mocks.  The mocks provide for separate testing of
 // the FIFO functions and the overall transaction management functions.
 OT_WEAK
-OT_ALIAS("dif_spi_host_fifo_write")
+OT_ALIAS("dif_spi_host_fifo_write_burst")
 dif_result_t spi_host_fifo_write_alias(const dif_spi_host_t *spi_host,
                                        const void *src, uint16_t len);
 
 OT_WEAK
-OT_ALIAS("dif_spi_host_fifo_read")
+OT_ALIAS("dif_spi_host_fifo_read_burst")
 dif_result_t spi_host_fifo_read_alias(const dif_spi_host_t *spi_host, void *dst,
                                       uint16_t len);
 
@@ -280,6 +280,211 @@ dif_result_t dif_spi_host_fifo_read(const dif_spi_host_t *spi_host, void *dst,
   return kDifOk;
 }
 
+/**
+ * Returns the number of free entries in the transmit FIFO.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param wait Whether to wait until there is at least one free entry.
+ */
+static uint32_t tx_fifo_space(const dif_spi_host_t *spi_host, bool wait) {
+  uint32_t space;
+  do {
+    uint32_t reg =
+        mmio_region_read32(spi_host->base_addr, SPI_HOST_STATUS_REG_OFFSET);
+    space = SPI_HOST_PARAM_TX_DEPTH -
+            bitfield_field32_read(reg, SPI_HOST_STATUS_TXQD_FIELD);
+  } while (wait && space == 0);
+  return space;
+}
+
+/**
+ * Returns the number of words in the receive FIFO.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param wait Whether to wait until there is at least one word.
+ */
+static uint32_t rx_fifo_depth(const dif_spi_host_t *spi_host, bool wait) {
+  uint32_t depth;
+  do {
+    uint32_t reg =
+        mmio_region_read32(spi_host->base_addr, SPI_HOST_STATUS_REG_OFFSET);
+    depth = bitfield_field32_read(reg, SPI_HOST_STATUS_RXQD_FIELD);
+  } while (wait && depth == 0);
+  return depth;
+}
+
+/**
+ * Merges a word with the bytes carried over from the previous word.
+ *
+ * @param[in,out] carry The `carry_bits / 8` bytes carried over from the
+ * previous word in its least significant bits. Updated with the bytes carried
+ * over from `word`.
+ * @param word The next word.
+ * @param carry_bits Number of bits in `carry`, must be 8, 16 or 24.
+ * @return The `carry` bytes followed by the leading bytes of `word`.
+ */
+static inline uint32_t shift_merge(uint32_t *carry, uint32_t word,
+                                   uint32_t carry_bits) {
+  uint32_t merged = *carry | (word << carry_bits);
+  *carry = word >> (32 - carry_bits);
+  return merged;
+}
+
+dif_result_t dif_spi_host_fifo_write_burst(const dif_spi_host_t *spi_host,
+                                           const void *src, uint16_t len) {
+  if (spi_host == NULL || (src == NULL && len > 0)) {
+    return kDifBadArg;
+  }
+
+  const uint8_t *ptr = (const uint8_t *)src;
+  const mmio_region_t base = spi_host->base_addr;
+  // Number of FIFO entries known to be free.
+  uint32_t space = 0;
+
+  // Gather the bytes up to the first word boundary of the source buffer so
+  // that the remainder of the buffer can be read as aligned words.
+  uint32_t carry = 0;
+  uint32_t carry_bits = 0;
+  while (misalignment32_of((uintptr_t)ptr) && len > 0) {
+    carry |= (uint32_t)*ptr++ << carry_bits;
+    carry_bits += 8;
+    len -= 1;
+  }
+
+  // Fill the free entries of the FIFO with complete words, checking the FIFO
+  // depth only once per burst.
+  uint32_t words = len / sizeof(uint32_t);
+  len -= (uint16_t)(words * sizeof(uint32_t));
+  while (words > 0) {
+    if (space == 0) {
+      space = tx_fifo_space(spi_host, /*wait=*/false);
+    }
+    uint32_t burst = space < words ? space : words;
+    space -= burst;
+    words -= burst;
+    if (carry_bits == 0) {
+      for (; burst >= 4; burst -= 4, ptr += 16) {
+        mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET, read_32(ptr));
+        mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET, read_32(ptr + 4));
+        mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET, read_32(ptr + 8));
+        mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET,
+                            read_32(ptr + 12));
+      }
+      for (; burst > 0; --burst, ptr += 4) {
+        mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET, read_32(ptr));
+      }
+    } else {
+      for (; burst > 0; --burst, ptr += 4) {
+        mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET,
+                            shift_merge(&carry, read_32(ptr), carry_bits));
+      }
+    }
+  }
+
+  // Append the trailing bytes to the carried over bytes. At most one complete
+  // word and three bytes remain.
+  while (len > 0) {
+    carry |= (uint32_t)*ptr++ << carry_bits;
+    carry_bits += 8;
+    len -= 1;
+    if (carry_bits == 32) {
+      if (space == 0) {
+        space = tx_fifo_space(spi_host, /*wait=*/true);
+      }
+      --space;
+      mmio_region_write32(base, SPI_HOST_TXDATA_REG_OFFSET, carry);
+      carry = 0;
+      carry_bits = 0;
+    }
+  }
+  for (; carry_bits > 0; carry_bits -= 8, carry >>= 8) {
+    if (space == 0) {
+      space = tx_fifo_space(spi_host, /*wait=*/true);
+    }
+    --space;
+    mmio_region_write8(base, SPI_HOST_TXDATA_REG_OFFSET, (uint8_t)carry);
+  }
+
+  return kDifOk;
+}
+
+dif_result_t dif_spi_host_fifo_read_burst(const dif_spi_host_t *spi_host,
+                                          void *dst, uint16_t len) {
+  if (spi_host == NULL || (dst == NULL && len > 0)) {
+    return kDifBadArg;
+  }
+
+  uint8_t *ptr = (uint8_t *)dst;
+  const mmio_region_t base = spi_host->base_addr;
+  // Number of FIFO entries known to be available.
+  uint32_t depth = 0;
+
+  // Store the bytes up to the first word boundary of the destination buffer
+  // from the first word and carry the rest over so that the remainder of the
+  // buffer can be written as aligned words.
+  uint32_t carry = 0;
+  uint32_t carry_bits = 0;
+  uint32_t head = (sizeof(uint32_t) - misalignment32_of((uintptr_t)ptr)) %
+                  sizeof(uint32_t);
+  if (head > len) {
+    head = len;
+  }
+  if (head > 0) {
+    depth = rx_fifo_depth(spi_host, /*wait=*/true) - 1;
+    carry = mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET);
+    carry_bits = 32;
+    len -= (uint16_t)head;
+    for (; head > 0; --head, carry >>= 8, carry_bits -= 8) {
+      *ptr++ = (uint8_t)carry;
+    }
+  }
+
+  // Drain the FIFO into complete words, checking the FIFO depth only once per
+  // burst.
+  uint32_t words = len / sizeof(uint32_t);
+  len -= (uint16_t)(words * sizeof(uint32_t));
+  while (words > 0) {
+    if (depth == 0) {
+      depth = rx_fifo_depth(spi_host, /*wait=*/false);
+    }
+    uint32_t burst = depth < words ? depth : words;
+    depth -= burst;
+    words -= burst;
+    if (carry_bits == 0) {
+      for (; burst >= 4; burst -= 4, ptr += 16) {
+        write_32(mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET), ptr);
+        write_32(mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET), ptr + 4);
+        write_32(mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET), ptr + 8);
+        write_32(mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET),
+                 ptr + 12);
+      }
+      for (; burst > 0; --burst, ptr += 4) {
+        write_32(mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET), ptr);
+      }
+    } else {
+      for (; burst > 0; --burst, ptr += 4) {
+        uint32_t word = mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET);
+        write_32(shift_merge(&carry, word, carry_bits), ptr);
+      }
+    }
+  }
+
+  // Finish up with the carried over bytes and, if needed, one more word.
+  for (; len > 0; --len, carry >>= 8, carry_bits -= 8) {
+    if (carry_bits == 0) {
+      if (depth == 0) {
+        depth = rx_fifo_depth(spi_host, /*wait=*/true);
+      }
+      --depth;
+      carry = mmio_region_read32(base, SPI_HOST_RXDATA_REG_OFFSET);
+      carry_bits = 32;
+    }
+    *ptr++ = (uint8_t)carry;
+  }
+
+  return kDifOk;
+}
+
 static void write_command_reg(const dif_spi_host_t *spi_host, uint16_t length,
                               dif_spi_host_width_t speed,
                               dif_spi_host_direction_t direction,
@@ -496,3 +701,12 @@ dif_result_t dif_spi_host_write_command(const dif_spi_host_t *spi_host,
   write_command_reg(spi_host, length, speed, direction, last_segment);
   return kDifOk;
 }
+
+dif_result_t dif_spi_host_set_csid(const dif_spi_host_t *spi_host,
+                                   uint32_t csid) {
+  if (spi_host == NULL) {
+    return kDifBadArg;
+  }
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_CSID_REG_OFFSET, csid);
+  return kDifOk;
+}
@@ -194,6 +194,40 @@ OT_WARN_UNUSED_RESULT
 dif_result_t dif_spi_host_fifo_read(const dif_spi_host_t *spi_host, void *dst,
                                     uint16_t len);
 
+/**
+ * Write to the SPI Host transmit FIFO in bursts.
+ *
+ * Unlike `dif_spi_host_fifo_write`, which checks the FIFO depth before every
+ * entry, this function reads `STATUS.TXQD` once and then writes as many
+ * 32-bit words as fit in the FIFO back to back. A misaligned source buffer is
+ * packed into whole 32-bit words rather than being written a byte at a time.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param src A pointer to the buffer to transmit.
+ * @param len The length of the transmit buffer.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_host_fifo_write_burst(const dif_spi_host_t *spi_host,
+                                           const void *src, uint16_t len);
+
+/**
+ * Read from the SPI Host receive FIFO in bursts.
+ *
+ * Unlike `dif_spi_host_fifo_read`, which checks the FIFO depth before every
+ * entry, this function reads `STATUS.RXQD` once and then drains that many
+ * 32-bit words back to back. A misaligned destination buffer is written with
+ * whole 32-bit words after the leading bytes.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param dst A pointer to the buffer to receive the data.
+ * @param len The length of the receive buffer.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_host_fifo_read_burst(const dif_spi_host_t *spi_host,
+                                          void *dst, uint16_t len);
+
 /**
  * Begins a SPI Host transaction.
  *
@@ -370,6 +404,20 @@ dif_result_t dif_spi_host_write_command(const dif_spi_host_t *spi_host,
                                         dif_spi_host_direction_t direction,
                                         bool last_segment);
 
+/**
+ * Selects the chip select line for the command segments issued next.
+ *
+ * The chip select ID is sampled when each command is written, so it only needs
+ * to be set before the first segment of a transaction.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param csid The chip select ID.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_host_set_csid(const dif_spi_host_t *spi_host,
+                                   uint32_t csid);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
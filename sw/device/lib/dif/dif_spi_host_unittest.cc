@@ -4,11 +4,15 @@
 
 #include "sw/device/lib/dif/dif_spi_host.h"
 
+#include <deque>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "sw/device/lib/base/global_mock.h"
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/base/mock_mmio.h"
+#include "sw/device/lib/base/mock_mmio_regfile.h"
 #include "sw/device/lib/dif/dif_test_base.h"
 
 #include "spi_host_regs.h"  // Generated.
@@ -521,6 +525,203 @@ TEST_F(FifoTest, MisalignedRead) {
   EXPECT_THAT(buffer.value, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8));
 }
 
+class FifoBurstTest : public SpiHostTest {};
+
+// Checks that arguments are validated.
+TEST_F(FifoBurstTest, NullArgs) {
+  uint32_t buffer[2] = {1, 2};
+
+  EXPECT_DIF_BADARG(
+      dif_spi_host_fifo_write_burst(nullptr, buffer, sizeof(buffer)));
+  EXPECT_DIF_BADARG(
+      dif_spi_host_fifo_write_burst(&spi_host_, nullptr, sizeof(buffer)));
+
+  EXPECT_DIF_BADARG(
+      dif_spi_host_fifo_read_burst(nullptr, buffer, sizeof(buffer)));
+  EXPECT_DIF_BADARG(
+      dif_spi_host_fifo_read_burst(&spi_host_, nullptr, sizeof(buffer)));
+}
+
+// Checks that an aligned source buffer is written in bursts limited by the
+// space in the transmit FIFO.
+TEST_F(FifoBurstTest, AlignedWrite) {
+  uint32_t buffer[] = {1, 2, 3, 4, 5, 6, 7};
+
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH - 5);
+  for (uint32_t i = 0; i < 5; ++i) {
+    EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, buffer[i]);
+  }
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH);
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH - 1);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 6);
+  EXPECT_TXQD(0);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 7);
+
+  EXPECT_DIF_OK(
+      dif_spi_host_fifo_write_burst(&spi_host_, buffer, sizeof(buffer)));
+}
+
+// Checks that a misaligned source buffer is packed into 32-bit words.
+TEST_F(FifoBurstTest, MisalignedWrite) {
+  Aligned<12, 4> buffer = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH - 3);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x04030201);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x08070605);
+  // The trailing bytes are written one at a time, the first one into the space
+  // that is known to be free.
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 9);
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH);
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH - 1);
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 10);
+
+  EXPECT_DIF_OK(
+      dif_spi_host_fifo_write_burst(&spi_host_, buffer.get() + 1, 10));
+}
+
+// Checks that a source buffer with misaligned start and end is written as a
+// whole number of words when possible.
+TEST_F(FifoBurstTest, MisalignedWriteWordTail) {
+  Aligned<12, 4> buffer = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+  EXPECT_TXQD(SPI_HOST_PARAM_TX_DEPTH - 1);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x05040302);
+  EXPECT_TXQD(0);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x09080706);
+
+  EXPECT_DIF_OK(dif_spi_host_fifo_write_burst(&spi_host_, buffer.get() + 2, 8));
+}
+
+// Checks that an aligned destination buffer is filled in bursts limited by
+// the depth of the receive FIFO.
+TEST_F(FifoBurstTest, AlignedRead) {
+  uint32_t buffer[6];
+
+  EXPECT_RXQD(4);
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, i + 1);
+  }
+  EXPECT_RXQD(0);
+  EXPECT_RXQD(8);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 5);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 6);
+
+  EXPECT_DIF_OK(
+      dif_spi_host_fifo_read_burst(&spi_host_, buffer, sizeof(buffer)));
+  EXPECT_THAT(buffer, ElementsAre(1, 2, 3, 4, 5, 6));
+}
+
+// Checks that a misaligned destination buffer receives the contents of the
+// receive FIFO.
+TEST_F(FifoBurstTest, MisalignedRead) {
+  Aligned<12, 4> buffer{};
+
+  EXPECT_RXQD(0);
+  EXPECT_RXQD(1);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x04030201);
+  EXPECT_RXQD(2);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x08070605);
+  // The last word is known to be available already.
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x0c0b0a09);
+
+  EXPECT_DIF_OK(dif_spi_host_fifo_read_burst(&spi_host_, buffer.get() + 1, 10));
+  EXPECT_THAT(buffer.value, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0));
+}
+
+// Checks that a short read into a misaligned destination buffer reads a single
+// word.
+TEST_F(FifoBurstTest, ShortRead) {
+  Aligned<4, 4> buffer{};
+
+  EXPECT_RXQD(1);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x04030201);
+
+  EXPECT_DIF_OK(dif_spi_host_fifo_read_burst(&spi_host_, buffer.get() + 1, 2));
+  EXPECT_THAT(buffer.value, ElementsAre(0, 1, 2, 0));
+}
+
+// Runs the burst functions against a behavioural model of the FIFOs, with the
+// device moving up to `kShifterWords` words in or out of the FIFOs between
+// status reads.
+class FifoBurstSimTest : public Test, public mock_mmio::RegisterFileTest {
+ protected:
+  static constexpr size_t kShifterWords = 16;
+
+  FifoBurstSimTest() {
+    dev().Ro(SPI_HOST_STATUS_REG_OFFSET);
+    dev().Fifo(SPI_HOST_TXDATA_REG_OFFSET);
+    dev().Fifo(SPI_HOST_RXDATA_REG_OFFSET);
+    dev().OnRead(SPI_HOST_STATUS_REG_OFFSET, [this] { Shift(); });
+  }
+
+  void Shift() {
+    auto &tx = dev().FifoData(SPI_HOST_TXDATA_REG_OFFSET);
+    auto &rx = dev().FifoData(SPI_HOST_RXDATA_REG_OFFSET);
+    for (size_t i = 0; i < kShifterWords && !tx.empty(); ++i) {
+      sent_.push_back(tx.front());
+      tx.pop_front();
+    }
+    for (size_t i = 0; i < kShifterWords && !to_receive_.empty() &&
+                       rx.size() < SPI_HOST_PARAM_RX_DEPTH;
+         ++i) {
+      rx.push_back(to_receive_.front());
+      to_receive_.pop_front();
+    }
+    dev().Set(SPI_HOST_STATUS_REG_OFFSET,
+              bitfield_field32_write(
+                  bitfield_field32_write(0, SPI_HOST_STATUS_TXQD_FIELD,
+                                         tx.size()),
+                  SPI_HOST_STATUS_RXQD_FIELD, rx.size()));
+  }
+
+  dif_spi_host_t spi_host_ = {.base_addr = dev().region()};
+  std::vector<uint32_t> sent_;
+  std::deque<uint32_t> to_receive_;
+};
+
+// Checks that a long write goes out in order, reading the status once per
+// burst rather than once per word.
+TEST_F(FifoBurstSimTest, LongWrite) {
+  std::vector<uint32_t> buffer(1000);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    buffer[i] = i * 0x01010101;
+  }
+
+  EXPECT_DIF_OK(dif_spi_host_fifo_write_burst(
+      &spi_host_, buffer.data(), buffer.size() * sizeof(uint32_t)));
+  while (!dev().FifoData(SPI_HOST_TXDATA_REG_OFFSET).empty()) {
+    Shift();
+  }
+  EXPECT_EQ(sent_, buffer);
+  EXPECT_EQ(dev().Writes(SPI_HOST_TXDATA_REG_OFFSET), buffer.size());
+  EXPECT_LE(dev().Reads(SPI_HOST_STATUS_REG_OFFSET),
+            buffer.size() / kShifterWords + 2);
+}
+
+// Checks that a long read into a misaligned buffer arrives in order, reading
+// the status once per burst rather than once per word.
+TEST_F(FifoBurstSimTest, LongMisalignedRead) {
+  constexpr size_t kWords = 1000;
+  // Byte `i` of the stream is `i % 256`.
+  for (uint32_t i = 0; i < kWords * sizeof(uint32_t); i += 4) {
+    uint32_t word = 0;
+    for (uint32_t j = 0; j < 4; ++j) {
+      word |= static_cast<uint32_t>(static_cast<uint8_t>(i + j)) << (8 * j);
+    }
+    to_receive_.push_back(word);
+  }
+
+  Aligned<kWords * sizeof(uint32_t) + 4, 4> buffer{};
+  EXPECT_DIF_OK(dif_spi_host_fifo_read_burst(&spi_host_, buffer.get() + 1,
+                                             kWords * sizeof(uint32_t)));
+  for (size_t i = 0; i < kWords * sizeof(uint32_t); ++i) {
+    EXPECT_EQ(buffer.value[i + 1], static_cast<uint8_t>(i));
+  }
+  EXPECT_EQ(dev().Reads(SPI_HOST_RXDATA_REG_OFFSET), kWords);
+  EXPECT_LE(dev().Reads(SPI_HOST_STATUS_REG_OFFSET),
+            kWords / kShifterWords + 2);
+}
+
 class EventEnableRegTest : public SpiHostTest {
  protected:
   static constexpr std::array<std::array<uint32_t, 2>, 6> kEventsMap{{
@@ -701,5 +902,16 @@ TEST_F(WriteCommandTest, ValidArgs) {
                                  kDifSpiHostDirectionBidirectional, false));
 }
 
+class SetCsidTest : public SpiHostTest {};
+
+TEST_F(SetCsidTest, NullArgs) {
+  EXPECT_DIF_BADARG(dif_spi_host_set_csid(nullptr, 0));
+}
+
+TEST_F(SetCsidTest, Write) {
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 2);
+  EXPECT_DIF_OK(dif_spi_host_set_csid(&spi_host_, 2));
+}
+
 }  // namespace
 }  // namespace dif_spi_host_unittest
@@ -527,6 +527,67 @@ dif_result_t dif_usbdev_buffer_write(const dif_usbdev_t *usbdev,
   return kDifOk;
 }
 
+dif_result_t dif_usbdev_buffer_span_get(const dif_usbdev_t *usbdev,
+                                        const dif_usbdev_buffer_t *buffer,
+                                        dif_usbdev_buffer_span_t *span) {
+  if (usbdev == NULL || buffer == NULL || span == NULL ||
+      (buffer->type != kDifUsbdevBufferTypeRead &&
+       buffer->type != kDifUsbdevBufferTypeWrite)) {
+    return kDifBadArg;
+  }
+  if (buffer->offset % sizeof(uint32_t) != 0) {
+    return kDifUnaligned;
+  }
+
+  span->offset = get_buffer_addr(buffer->id, buffer->offset);
+  span->len = buffer->remaining_bytes;
+  return kDifOk;
+}
+
+dif_result_t dif_usbdev_buffer_span_commit(
+    const dif_usbdev_t *usbdev, dif_usbdev_buffer_pool_t *buffer_pool,
+    dif_usbdev_buffer_t *buffer, size_t len) {
+  if (usbdev == NULL || buffer_pool == NULL || buffer == NULL ||
+      (buffer->type != kDifUsbdevBufferTypeRead &&
+       buffer->type != kDifUsbdevBufferTypeWrite) ||
+      len > buffer->remaining_bytes) {
+    return kDifBadArg;
+  }
+
+  buffer->offset += len;
+  buffer->remaining_bytes -= len;
+
+  // Write buffers are returned to the free buffer pool once they are sent.
+  if (buffer->type == kDifUsbdevBufferTypeWrite ||
+      buffer->remaining_bytes > 0) {
+    return kDifOk;
+  }
+
+  // Return the buffer to the free buffer pool
+  if (!buffer_pool_add(buffer_pool, buffer->id)) {
+    return kDifError;
+  }
+
+  // Mark the buffer as stale
+  buffer->type = kDifUsbdevBufferTypeStale;
+  return kDifOk;
+}
+
+dif_result_t dif_usbdev_buffer_forward(const dif_usbdev_t *usbdev,
+                                       dif_usbdev_buffer_t *buffer) {
+  if (usbdev == NULL || buffer == NULL ||
+      buffer->type != kDifUsbdevBufferTypeRead) {
+    return kDifBadArg;
+  }
+
+  // The payload of the outgoing packet is the entire payload of the received
+  // packet, which ends at `offset + remaining_bytes`.
+  buffer->offset += buffer->remaining_bytes;
+  buffer->remaining_bytes = USBDEV_BUFFER_ENTRY_SIZE_BYTES - buffer->offset;
+  buffer->type = kDifUsbdevBufferTypeWrite;
+  return kDifOk;
+}
+
 dif_result_t dif_usbdev_send(const dif_usbdev_t *usbdev, uint8_t endpoint,
                              dif_usbdev_buffer_t *buffer) {
   if (usbdev == NULL || !is_valid_endpoint(endpoint) || buffer == NULL ||
@@ -480,6 +480,95 @@ dif_result_t dif_usbdev_buffer_write(const dif_usbdev_t *usbdev,
                                      const uint8_t *src, size_t src_len,
                                      size_t *bytes_written);
 
+/**
+ * A word-aligned region of a USB device buffer.
+ *
+ * See also: `dif_usbdev_buffer_span_get`.
+ */
+typedef struct dif_usbdev_buffer_span {
+  /**
+   * Offset of the first word of the region from `dif_usbdev_t.base_addr`.
+   *
+   * This offset is word aligned and can be used directly with
+   * `mmio_region_read32` and `mmio_region_write32`.
+   */
+  ptrdiff_t offset;
+  /**
+   * For read buffers: remaining number of bytes to read.
+   * For write buffers: remaining number of bytes that can be written.
+   */
+  size_t len;
+} dif_usbdev_buffer_span_t;
+
+/**
+ * Get the unconsumed region of a buffer for in-place access.
+ *
+ * Clients can call this function instead of `dif_usbdev_buffer_read` or
+ * `dif_usbdev_buffer_write` to access the payload of a packet directly in the
+ * packet buffer, one word at a time, e.g. to fill or checksum it without
+ * copying it to or from an intermediate buffer. After accessing the region,
+ * clients must call `dif_usbdev_buffer_span_commit` with the number of bytes
+ * that were consumed.
+ *
+ * When the length of the region is not a multiple of the word size, the bytes
+ * past `span->len` in the last word of a read buffer are undefined.
+ *
+ * See also: `dif_usbdev_buffer_span_commit`.
+ *
+ * @param usbdev A USB device.
+ * @param buffer A buffer provided by `dif_usbdev_recv` or
+ *               `dif_usbdev_buffer_request`.
+ * @param[out] span The unconsumed region of the buffer.
+ * @return The result of the operation, `kDifUnaligned` if the buffer was
+ *         previously consumed up to an offset that is not word aligned.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_buffer_span_get(const dif_usbdev_t *usbdev,
+                                        const dif_usbdev_buffer_t *buffer,
+                                        dif_usbdev_buffer_span_t *span);
+
+/**
+ * Mark a number of bytes of a buffer as consumed.
+ *
+ * This function updates the state of the buffer after clients access its
+ * payload in place through `dif_usbdev_buffer_span_get`. Like
+ * `dif_usbdev_buffer_read`, this function returns a read buffer to the free
+ * buffer pool once its entire payload is consumed.
+ *
+ * See also: `dif_usbdev_buffer_span_get`.
+ *
+ * @param usbdev A USB device.
+ * @param buffer_pool A USB device buffer pool.
+ * @param buffer A buffer provided by `dif_usbdev_recv` or
+ *               `dif_usbdev_buffer_request`.
+ * @param len Number of bytes read from or written to the buffer, must not be
+ *            larger than the remaining number of bytes in the buffer.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_buffer_span_commit(
+    const dif_usbdev_t *usbdev, dif_usbdev_buffer_pool_t *buffer_pool,
+    dif_usbdev_buffer_t *buffer, size_t len);
+
+/**
+ * Turn a received packet into an outgoing packet.
+ *
+ * This function converts a buffer provided by `dif_usbdev_recv` into a write
+ * buffer that holds the entire payload of the received packet, regardless of
+ * how much of it was already read. Clients can append to the payload with
+ * `dif_usbdev_buffer_write` and then call `dif_usbdev_send` to send it back
+ * to the host, e.g. for loopback or forwarding, without copying it.
+ *
+ * See also: `dif_usbdev_recv`, `dif_usbdev_send`.
+ *
+ * @param usbdev A USB device.
+ * @param buffer A buffer provided by `dif_usbdev_recv`.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_usbdev_buffer_forward(const dif_usbdev_t *usbdev,
+                                       dif_usbdev_buffer_t *buffer);
+
 /**
  * Mark a packet ready for transmission from an endpoint.
  *
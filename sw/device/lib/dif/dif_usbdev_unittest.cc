@@ -32,6 +32,7 @@ TEST_F(UsbdevTest, NullArgsTest) {
   bool bool_arg;
   dif_usbdev_rx_packet_info_t packet_info;
   dif_usbdev_buffer_t buffer;
+  dif_usbdev_buffer_span_t span;
   uint8_t uint8_arg;
   size_t size_arg;
   dif_usbdev_endpoint_id_t endpoint_id;
@@ -90,6 +91,17 @@ TEST_F(UsbdevTest, NullArgsTest) {
                                             /*src_len=*/1, &size_arg));
   EXPECT_DIF_BADARG(dif_usbdev_buffer_write(&usbdev_, &buffer, &uint8_arg,
                                             /*src_len=*/1, nullptr));
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_span_get(nullptr, &buffer, &span));
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_span_get(&usbdev_, nullptr, &span));
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_span_get(&usbdev_, &buffer, nullptr));
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_span_commit(nullptr, &buffer_pool,
+                                                  &buffer, /*len=*/0));
+  EXPECT_DIF_BADARG(
+      dif_usbdev_buffer_span_commit(&usbdev_, nullptr, &buffer, /*len=*/0));
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_span_commit(&usbdev_, &buffer_pool,
+                                                  nullptr, /*len=*/0));
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_forward(nullptr, &buffer));
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_forward(&usbdev_, nullptr));
   EXPECT_DIF_BADARG(dif_usbdev_send(nullptr, /*endpoint=*/0, &buffer));
   EXPECT_DIF_BADARG(dif_usbdev_send(&usbdev_, /*endpoint=*/0, nullptr));
   EXPECT_DIF_BADARG(dif_usbdev_get_tx_sent(nullptr, &uint16_arg));
@@ -791,6 +803,165 @@ TEST_F(UsbdevTest, InPacket) {
       dif_usbdev_clear_tx_status(&usbdev_, &buffer_pool, /*endpoint=*/5));
 }
 
+class BufferSpanTest : public UsbdevTest {
+ protected:
+  void SetUp() override {
+    EXPECT_WRITE32(USBDEV_PHY_CONFIG_REG_OFFSET,
+                   {
+                       {USBDEV_PHY_CONFIG_USE_DIFF_RCVR_BIT, 1},
+                       {USBDEV_PHY_CONFIG_TX_USE_D_SE0_BIT, 0},
+                       {USBDEV_PHY_CONFIG_EOP_SINGLE_BIT_BIT, 0},
+                       {USBDEV_PHY_CONFIG_PINFLIP_BIT, 0},
+                       {USBDEV_PHY_CONFIG_USB_REF_DISABLE_BIT, 0},
+                   });
+    EXPECT_DIF_OK(dif_usbdev_configure(&usbdev_, &buffer_pool_, phy_config_));
+  }
+
+  /**
+   * Receives an OUT packet of `size` bytes.
+   *
+   * The packet is received in a buffer taken from the free buffer pool as if
+   * it was supplied to the AV FIFO.
+   */
+  void Recv(uint32_t size) {
+    EXPECT_DIF_OK(
+        dif_usbdev_buffer_request(&usbdev_, &buffer_pool_, &buffer_));
+    uint8_t buffer_id = buffer_.id;
+    dif_usbdev_rx_packet_info_t rx_packet_info;
+    EXPECT_READ32(USBDEV_USBSTAT_REG_OFFSET,
+                  {
+                      {USBDEV_USBSTAT_LINK_STATE_OFFSET,
+                       USBDEV_USBSTAT_LINK_STATE_VALUE_ACTIVE},
+                      {USBDEV_USBSTAT_SENSE_BIT, 1},
+                      {USBDEV_USBSTAT_RX_EMPTY_BIT, 0},
+                  });
+    EXPECT_READ32(USBDEV_RXFIFO_REG_OFFSET,
+                  {
+                      {USBDEV_RXFIFO_EP_OFFSET, 1},
+                      {USBDEV_RXFIFO_SETUP_BIT, 0},
+                      {USBDEV_RXFIFO_SIZE_OFFSET, size},
+                      {USBDEV_RXFIFO_BUFFER_OFFSET, buffer_id},
+                  });
+    EXPECT_DIF_OK(dif_usbdev_recv(&usbdev_, &rx_packet_info, &buffer_));
+    EXPECT_EQ(buffer_.id, buffer_id);
+    EXPECT_EQ(buffer_.remaining_bytes, size);
+  }
+
+  dif_usbdev_config_t phy_config_ = {
+      .have_differential_receiver = kDifToggleEnabled,
+      .use_tx_d_se0 = kDifToggleDisabled,
+      .single_bit_eop = kDifToggleDisabled,
+      .pin_flip = kDifToggleDisabled,
+      .clock_sync_signals = kDifToggleEnabled,
+  };
+  dif_usbdev_buffer_pool_t buffer_pool_;
+  dif_usbdev_buffer_t buffer_;
+  dif_usbdev_buffer_span_t span_;
+};
+
+TEST_F(BufferSpanTest, Read) {
+  Recv(/*size=*/10);
+  int8_t top = buffer_pool_.top;
+
+  EXPECT_DIF_OK(dif_usbdev_buffer_span_get(&usbdev_, &buffer_, &span_));
+  EXPECT_EQ(span_.offset, USBDEV_BUFFER_REG_OFFSET + buffer_.id * 64);
+  EXPECT_EQ(span_.len, 10);
+  EXPECT_READ32(span_.offset, 0x03020100);
+  EXPECT_READ32(span_.offset + 4, 0x07060504);
+  EXPECT_EQ(mmio_region_read32(usbdev_.base_addr, span_.offset), 0x03020100);
+  EXPECT_EQ(mmio_region_read32(usbdev_.base_addr, span_.offset + 4),
+            0x07060504);
+  EXPECT_DIF_OK(
+      dif_usbdev_buffer_span_commit(&usbdev_, &buffer_pool_, &buffer_, 8));
+  EXPECT_EQ(buffer_.type, kDifUsbdevBufferTypeRead);
+
+  EXPECT_DIF_OK(dif_usbdev_buffer_span_get(&usbdev_, &buffer_, &span_));
+  EXPECT_EQ(span_.offset, USBDEV_BUFFER_REG_OFFSET + buffer_.id * 64 + 8);
+  EXPECT_EQ(span_.len, 2);
+  // Can't consume more than the remaining bytes.
+  EXPECT_DIF_BADARG(
+      dif_usbdev_buffer_span_commit(&usbdev_, &buffer_pool_, &buffer_, 3));
+
+  // The buffer is returned to the pool once the payload is consumed.
+  EXPECT_DIF_OK(
+      dif_usbdev_buffer_span_commit(&usbdev_, &buffer_pool_, &buffer_, 2));
+  EXPECT_EQ(buffer_.type, kDifUsbdevBufferTypeStale);
+  EXPECT_EQ(buffer_pool_.top, top + 1);
+  EXPECT_EQ(buffer_pool_.buffers[buffer_pool_.top], buffer_.id);
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_span_get(&usbdev_, &buffer_, &span_));
+}
+
+TEST_F(BufferSpanTest, Unaligned) {
+  Recv(/*size=*/8);
+
+  uint8_t byte;
+  size_t bytes_written;
+  EXPECT_READ32(USBDEV_BUFFER_REG_OFFSET + buffer_.id * 64, 0x03020100);
+  EXPECT_DIF_OK(dif_usbdev_buffer_read(&usbdev_, &buffer_pool_, &buffer_,
+                                       &byte, sizeof(byte), &bytes_written));
+  EXPECT_EQ(dif_usbdev_buffer_span_get(&usbdev_, &buffer_, &span_),
+            kDifUnaligned);
+}
+
+TEST_F(BufferSpanTest, Write) {
+  EXPECT_DIF_OK(dif_usbdev_buffer_request(&usbdev_, &buffer_pool_, &buffer_));
+  int8_t top = buffer_pool_.top;
+
+  EXPECT_DIF_OK(dif_usbdev_buffer_span_get(&usbdev_, &buffer_, &span_));
+  EXPECT_EQ(span_.offset, USBDEV_BUFFER_REG_OFFSET + buffer_.id * 64);
+  EXPECT_EQ(span_.len, 64);
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_WRITE32(span_.offset + i * 4, i);
+    mmio_region_write32(usbdev_.base_addr, span_.offset + i * 4, i);
+  }
+  EXPECT_DIF_OK(
+      dif_usbdev_buffer_span_commit(&usbdev_, &buffer_pool_, &buffer_, 16));
+  // Write buffers are not returned to the pool when full.
+  EXPECT_DIF_OK(
+      dif_usbdev_buffer_span_commit(&usbdev_, &buffer_pool_, &buffer_, 48));
+  EXPECT_EQ(buffer_.type, kDifUsbdevBufferTypeWrite);
+  EXPECT_EQ(buffer_pool_.top, top);
+
+  EXPECT_WRITE32(USBDEV_CONFIGIN_2_REG_OFFSET,
+                 {
+                     {USBDEV_CONFIGIN_2_BUFFER_2_OFFSET, buffer_.id},
+                     {USBDEV_CONFIGIN_2_SIZE_2_OFFSET, 64},
+                 });
+  EXPECT_WRITE32(USBDEV_CONFIGIN_2_REG_OFFSET,
+                 {
+                     {USBDEV_CONFIGIN_2_BUFFER_2_OFFSET, buffer_.id},
+                     {USBDEV_CONFIGIN_2_SIZE_2_OFFSET, 64},
+                     {USBDEV_CONFIGIN_2_RDY_2_BIT, 1},
+                 });
+  EXPECT_DIF_OK(dif_usbdev_send(&usbdev_, /*endpoint=*/2, &buffer_));
+}
+
+TEST_F(BufferSpanTest, Forward) {
+  Recv(/*size=*/12);
+  EXPECT_DIF_OK(
+      dif_usbdev_buffer_span_commit(&usbdev_, &buffer_pool_, &buffer_, 4));
+
+  EXPECT_DIF_OK(dif_usbdev_buffer_forward(&usbdev_, &buffer_));
+  EXPECT_EQ(buffer_.type, kDifUsbdevBufferTypeWrite);
+  EXPECT_EQ(buffer_.offset, 12);
+  EXPECT_EQ(buffer_.remaining_bytes, 64 - 12);
+  // Can't forward a write buffer.
+  EXPECT_DIF_BADARG(dif_usbdev_buffer_forward(&usbdev_, &buffer_));
+
+  EXPECT_WRITE32(USBDEV_CONFIGIN_1_REG_OFFSET,
+                 {
+                     {USBDEV_CONFIGIN_1_BUFFER_1_OFFSET, buffer_.id},
+                     {USBDEV_CONFIGIN_1_SIZE_1_OFFSET, 12},
+                 });
+  EXPECT_WRITE32(USBDEV_CONFIGIN_1_REG_OFFSET,
+                 {
+                     {USBDEV_CONFIGIN_1_BUFFER_1_OFFSET, buffer_.id},
+                     {USBDEV_CONFIGIN_1_SIZE_1_OFFSET, 12},
+                     {USBDEV_CONFIGIN_1_RDY_1_BIT, 1},
+                 });
+  EXPECT_DIF_OK(dif_usbdev_send(&usbdev_, /*endpoint=*/1, &buffer_));
+}
+
 TEST_F(UsbdevTest, DeviceAddresses) {
   uint8_t address = 101;
   EXPECT_READ32(USBDEV_USBCTRL_REG_OFFSET,
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "sw/device/lib/testing/entropy_testutils.h"
 
+#include "sw/device/lib/base/bitfield.h"
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/dif/dif_csrng.h"
 #include "sw/device/lib/dif/dif_csrng_shared.h"
@@ -243,3 +244,62 @@ status_t entropy_testutils_error_check(const dif_entropy_src_t *entropy_src,
   TRY_CHECK(!found_error, "entropy_testutils_error_check fail");
   return OK_STATUS();
 }
+
+enum {
+  /**
+   * Width of an RNG symbol in the observe FIFO, in bits.
+   */
+  kObserveFifoSymbolBits = 4,
+  kObserveFifoSymbolMask = (1 << kObserveFifoSymbolBits) - 1,
+  kObserveFifoSymbolsPerWord = 32 / kObserveFifoSymbolBits,
+};
+
+/**
+ * Runs the software health tests over the symbols packed into `word`.
+ *
+ * @param tests Health test state to update.
+ * @param word A word read from the observe FIFO.
+ */
+static void health_tests_update_word(entropy_testutils_health_tests_t *tests,
+                                     uint32_t word) {
+  for (size_t i = 0; i < kObserveFifoSymbolsPerWord; ++i) {
+    uint32_t symbol = word & kObserveFifoSymbolMask;
+    word >>= kObserveFifoSymbolBits;
+
+    if (tests->repcnt_threshold != 0) {
+      if (tests->repcnt_count != 0 && symbol == tests->repcnt_symbol) {
+        ++tests->repcnt_count;
+      } else {
+        tests->repcnt_symbol = symbol;
+        tests->repcnt_count = 1;
+      }
+      if (tests->repcnt_count >= tests->repcnt_threshold) {
+        ++tests->repcnt_failures;
+        tests->repcnt_count = 0;
+      }
+    }
+
+    if (tests->adaptp_window_size != 0) {
+      tests->adaptp_ones += (uint32_t)bitfield_popcount32(symbol);
+      if (++tests->adaptp_symbols == tests->adaptp_window_size) {
+        if (tests->adaptp_ones > tests->adaptp_high_threshold ||
+            tests->adaptp_ones < tests->adaptp_low_threshold) {
+          ++tests->adaptp_failures;
+        }
+        tests->adaptp_symbols = 0;
+        tests->adaptp_ones = 0;
+      }
+    }
+  }
+}
+
+status_t entropy_testutils_health_tests_update(
+    entropy_testutils_health_tests_t *tests, const uint32_t *words,
+    size_t len) {
+  TRY_CHECK(tests != NULL);
+  TRY_CHECK(words != NULL || len == 0);
+  for (size_t i = 0; i < len; ++i) {
+    health_tests_update_word(tests, words[i]);
+  }
+  return OK_STATUS();
+}
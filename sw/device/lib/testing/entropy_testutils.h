@@ -10,6 +10,58 @@
 #include "sw/device/lib/dif/dif_edn.h"
 #include "sw/device/lib/dif/dif_entropy_src.h"
 
+/**
+ * Running state of software health tests over observe FIFO data.
+ *
+ * The observe FIFO carries 4-bit RNG symbols, packed eight to a word with the
+ * oldest symbol in the least significant nibble. Both tests run incrementally
+ * across calls to `entropy_testutils_health_tests_update()`, so a window or a
+ * run of repeated symbols may straddle several reads.
+ *
+ * Callers set the threshold fields and zero everything else before the first
+ * update; the failure counters may be inspected (and cleared) between updates.
+ */
+typedef struct entropy_testutils_health_tests {
+  /**
+   * The repetition count test fails when the same symbol is seen this many
+   * times in a row. Set to 0 to disable the test.
+   */
+  uint32_t repcnt_threshold;
+  /**
+   * The number of symbols in each adaptive proportion test window. Set to 0 to
+   * disable the test.
+   */
+  uint32_t adaptp_window_size;
+  /**
+   * The adaptive proportion test fails when a window contains more than this
+   * many set bits.
+   */
+  uint32_t adaptp_high_threshold;
+  /**
+   * The adaptive proportion test fails when a window contains fewer than this
+   * many set bits.
+   */
+  uint32_t adaptp_low_threshold;
+  /**
+   * The number of repetition count test failures seen so far.
+   */
+  uint32_t repcnt_failures;
+  /**
+   * The number of adaptive proportion test failures seen so far.
+   */
+  uint32_t adaptp_failures;
+  /**
+   * The most recent symbol and the length of the run it ends.
+   */
+  uint32_t repcnt_symbol;
+  uint32_t repcnt_count;
+  /**
+   * The number of symbols and set bits seen in the current window.
+   */
+  uint32_t adaptp_symbols;
+  uint32_t adaptp_ones;
+} entropy_testutils_health_tests_t;
+
 /**
  * Returns default entropy source configuration.
  */
@@ -85,4 +137,18 @@ status_t entropy_testutils_error_check(const dif_entropy_src_t *entropy_src,
                                        const dif_edn_t *edn0,
                                        const dif_edn_t *edn1);
 
+/**
+ * Runs the software repetition count and adaptive proportion tests over words
+ * drained from the observe FIFO, e.g. with
+ * `dif_entropy_src_observe_fifo_read_stream()`.
+ *
+ * @param tests Health test state to update.
+ * @param words Words read from the observe FIFO, oldest first.
+ * @param len The number of words in `words`.
+ * @return The result of the operation.
+ */
+status_t entropy_testutils_health_tests_update(
+    entropy_testutils_health_tests_t *tests, const uint32_t *words,
+    size_t len);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_ENTROPY_TESTUTILS_H_
@@ -69,10 +69,6 @@ status_t i2c_testutils_wr(const dif_i2c_t *i2c, uint8_t addr,
   // The current function does not support initializing a write while another
   // transaction is in progress
 
-  // TODO: The current function does not support write payloads
-  // larger than the fifo depth.
-  TRY_CHECK(byte_count <= I2C_PARAM_FIFO_DEPTH);
-
   // TODO: #15377 The I2C DIF says: "Callers should prefer
   // `dif_i2c_write_byte()` instead, since that function provides clearer
   // semantics. This function should only really be used for testing or
@@ -83,12 +79,14 @@ status_t i2c_testutils_wr(const dif_i2c_t *i2c, uint8_t addr,
   data_frame = (addr << 1) | kI2cWrite;
   TRY(dif_i2c_write_byte_raw(i2c, data_frame, flags));
 
-  // Once address phase is through, blast the rest as generic data.
-  flags = kDefaultFlags;
-  for (uint8_t i = 0; i < byte_count; ++i) {
-    // Issue a stop for the last byte.
-    flags.stop = ((i == byte_count - 1) && !skip_stop);
-    TRY(dif_i2c_write_byte_raw(i2c, data[i], flags));
+  // Once address phase is through, blast the rest as generic data, as much as
+  // fits in the FIFO at a time.
+  size_t written = 0;
+  while (written < byte_count) {
+    size_t count;
+    TRY(dif_i2c_write_bytes(i2c, data + written, byte_count - written,
+                            !skip_stop, &count));
+    written += count;
   }
 
   // TODO: Check for errors / status.
@@ -164,9 +162,9 @@ status_t i2c_testutils_target_rd(const dif_i2c_t *i2c, uint8_t byte_count,
   TRY_CHECK(tx_fifo_lvl + byte_count <= I2C_PARAM_FIFO_DEPTH);
   TRY_CHECK(acq_fifo_lvl + 2 <= I2C_PARAM_FIFO_DEPTH);
 
-  for (uint8_t i = 0; i < byte_count; ++i) {
-    TRY(dif_i2c_transmit_byte(i2c, data[i]));
-  }
+  size_t written;
+  TRY(dif_i2c_transmit_bytes(i2c, data, byte_count, &written));
+  TRY_CHECK(written == byte_count);
   // TODO: Check for errors / status.
   return OK_STATUS();
 }
@@ -198,10 +196,12 @@ status_t i2c_testutils_target_check_wr(const dif_i2c_t *i2c, uint8_t byte_count,
   int32_t dir = TRY(i2c_testutils_target_check_start(i2c, addr));
   TRY_CHECK(dir == kI2cWrite);
 
+  dif_i2c_signal_t signals[I2C_PARAM_FIFO_DEPTH];
+  size_t read;
+  TRY(dif_i2c_acquire_bytes(i2c, bytes, signals, byte_count, &read));
+  TRY_CHECK(read == byte_count);
   for (uint8_t i = 0; i < byte_count; ++i) {
-    dif_i2c_signal_t signal;
-    TRY(dif_i2c_acquire_byte(i2c, bytes + i, &signal));
-    TRY_CHECK(signal == kDifI2cSignalNone);
+    TRY_CHECK(signals[i] == kDifI2cSignalNone);
   }
 
   // TODO: Check for errors / status.
@@ -209,6 +209,84 @@ status_t i2c_testutils_target_check_wr(const dif_i2c_t *i2c, uint8_t byte_count,
   return i2c_testutils_target_check_end(i2c, cont_byte);
 }
 
+/**
+ * Returns the interrupt that services a FIFO.
+ */
+static dif_i2c_irq_t fifo_irq(i2c_testutils_fifo_t fifo) {
+  switch (fifo) {
+    case kI2cTestutilsFifoFmt:
+      return kDifI2cIrqFmtThreshold;
+    case kI2cTestutilsFifoRx:
+      return kDifI2cIrqRxThreshold;
+    case kI2cTestutilsFifoTx:
+      return kDifI2cIrqTxStretch;
+    default:
+      return kDifI2cIrqAcqFull;
+  }
+}
+
+/**
+ * Enables or disables the interrupts that service a FIFO transfer.
+ *
+ * The RX and ACQ threshold interrupts only fire while the FIFO is above the
+ * threshold, so the tail of those transfers is drained on
+ * `kDifI2cIrqCmdComplete`, which fires on the STOP or repeated START that ends
+ * the transaction.
+ */
+static status_t fifo_irqs_set_enabled(const dif_i2c_t *i2c,
+                                      i2c_testutils_fifo_t fifo,
+                                      dif_toggle_t enabled) {
+  TRY(dif_i2c_irq_set_enabled(i2c, fifo_irq(fifo), enabled));
+  if (fifo == kI2cTestutilsFifoRx || fifo == kI2cTestutilsFifoAcq) {
+    TRY(dif_i2c_irq_set_enabled(i2c, kDifI2cIrqCmdComplete, enabled));
+  }
+  return OK_STATUS();
+}
+
+status_t i2c_testutils_fifo_xfer_service(const dif_i2c_t *i2c,
+                                         i2c_testutils_fifo_xfer_t *xfer) {
+  size_t remaining = xfer->len - xfer->done;
+  size_t count = 0;
+  switch (xfer->fifo) {
+    case kI2cTestutilsFifoFmt:
+      TRY(dif_i2c_write_bytes(i2c, xfer->src + xfer->done, remaining,
+                              xfer->stop, &count));
+      break;
+    case kI2cTestutilsFifoRx:
+      TRY(dif_i2c_read_bytes(i2c, xfer->dst + xfer->done, remaining, &count));
+      break;
+    case kI2cTestutilsFifoTx:
+      TRY(dif_i2c_transmit_bytes(i2c, xfer->src + xfer->done, remaining,
+                                 &count));
+      break;
+    case kI2cTestutilsFifoAcq:
+      TRY(dif_i2c_acquire_bytes(
+          i2c, xfer->dst + xfer->done,
+          xfer->signals != NULL ? xfer->signals + xfer->done : NULL, remaining,
+          &count));
+      break;
+    default:
+      return INVALID_ARGUMENT();
+  }
+  xfer->done += count;
+
+  bool done = xfer->done == xfer->len;
+  if (done) {
+    TRY(fifo_irqs_set_enabled(i2c, xfer->fifo, kDifToggleDisabled));
+  }
+  return OK_STATUS(done);
+}
+
+status_t i2c_testutils_fifo_xfer_start(const dif_i2c_t *i2c,
+                                       i2c_testutils_fifo_xfer_t *xfer) {
+  xfer->done = 0;
+  bool done = TRY(i2c_testutils_fifo_xfer_service(i2c, xfer));
+  if (!done) {
+    TRY(fifo_irqs_set_enabled(i2c, xfer->fifo, kDifToggleEnabled));
+  }
+  return OK_STATUS(done);
+}
+
 status_t i2c_testutils_connect_i2c_to_pinmux_pins(const dif_pinmux_t *pinmux,
                                                   uint8_t kI2cIdx) {
   top_earlgrey_pinmux_mio_out_t i2c_pinmux_out1_id, i2c_pinmux_out2_id;
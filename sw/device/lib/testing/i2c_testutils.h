@@ -5,6 +5,8 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_I2C_TESTUTILS_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_I2C_TESTUTILS_H_
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/base/status.h"
@@ -111,6 +113,100 @@ status_t i2c_testutils_target_check_wr(const dif_i2c_t *i2c, uint8_t byte_count,
                                        uint8_t *addr, uint8_t *bytes,
                                        uint8_t *cont_byte);
 
+/**
+ * FIFOs that an `i2c_testutils_fifo_xfer_t` can move data through.
+ */
+typedef enum i2c_testutils_fifo {
+  /**
+   * Host mode writes, serviced from `kDifI2cIrqFmtThreshold`.
+   */
+  kI2cTestutilsFifoFmt,
+  /**
+   * Host mode reads, serviced from `kDifI2cIrqRxThreshold` and
+   * `kDifI2cIrqCmdComplete`.
+   */
+  kI2cTestutilsFifoRx,
+  /**
+   * Target mode reads, serviced from `kDifI2cIrqTxStretch`.
+   */
+  kI2cTestutilsFifoTx,
+  /**
+   * Target mode writes, serviced from `kDifI2cIrqAcqFull` and
+   * `kDifI2cIrqCmdComplete`.
+   */
+  kI2cTestutilsFifoAcq,
+} i2c_testutils_fifo_t;
+
+/**
+ * A buffer transfer through one of the I2C FIFOs that is moved along in bursts
+ * from the FIFO's interrupt.
+ */
+typedef struct i2c_testutils_fifo_xfer {
+  /**
+   * The FIFO to move data through.
+   */
+  i2c_testutils_fifo_t fifo;
+  /**
+   * Source buffer for `kI2cTestutilsFifoFmt` and `kI2cTestutilsFifoTx`.
+   */
+  const uint8_t *src;
+  /**
+   * Destination buffer for `kI2cTestutilsFifoRx` and `kI2cTestutilsFifoAcq`.
+   */
+  uint8_t *dst;
+  /**
+   * Destination for the signals of `kI2cTestutilsFifoAcq` bytes; may be NULL.
+   */
+  dif_i2c_signal_t *signals;
+  /**
+   * Number of bytes to transfer.
+   */
+  size_t len;
+  /**
+   * Whether the last `kI2cTestutilsFifoFmt` byte is followed by a stop.
+   */
+  bool stop;
+  /**
+   * Number of bytes transferred so far.
+   */
+  size_t done;
+} i2c_testutils_fifo_xfer_t;
+
+/**
+ * Starts a FIFO transfer.
+ *
+ * Moves the first burst and, if the transfer is not complete yet, enables the
+ * interrupts that service the transfer's FIFO. The interrupt handler should
+ * call `i2c_testutils_fifo_xfer_service()` for each of them.
+ *
+ * The RX and ACQ interrupts only fire while the FIFO is full or above its
+ * threshold, so a tail below that level would never be drained. Transfers
+ * through these FIFOs also enable `kDifI2cIrqCmdComplete`, which fires on the
+ * STOP or repeated START that ends the transaction, to drain the tail.
+ *
+ * @param i2c An I2C DIF handle.
+ * @param xfer The transfer, `done` is reset.
+ * @return kOk(done) Where done indicates that the transfer is complete, or an
+ * error.
+ */
+status_t i2c_testutils_fifo_xfer_start(const dif_i2c_t *i2c,
+                                       i2c_testutils_fifo_xfer_t *xfer);
+
+/**
+ * Moves the next burst of a FIFO transfer.
+ *
+ * Disables the interrupts enabled by `i2c_testutils_fifo_xfer_start()` once
+ * the transfer is complete, including `kDifI2cIrqCmdComplete` for RX and ACQ
+ * transfers.
+ *
+ * @param i2c An I2C DIF handle.
+ * @param xfer The transfer.
+ * @return kOk(done) Where done indicates that the transfer is complete, or an
+ * error.
+ */
+status_t i2c_testutils_fifo_xfer_service(const dif_i2c_t *i2c,
+                                         i2c_testutils_fifo_xfer_t *xfer);
+
 /**
  * Initialize the pinmux.
  *
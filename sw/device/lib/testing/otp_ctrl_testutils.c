@@ -145,3 +145,96 @@ status_t otp_ctrl_testutils_dai_write64(const dif_otp_ctrl_t *otp,
   }
   return OK_STATUS();
 }
+
+/**
+ * Polls the DAI status until the DAI is idle and returns the last status read.
+ *
+ * Unlike `otp_ctrl_testutils_wait_for_dai()`, the caller can check the result
+ * of the operation without reading the status again.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t dai_wait_status(const dif_otp_ctrl_t *otp,
+                                dif_otp_ctrl_status_t *status) {
+  IBEX_TRY_SPIN_FOR(
+      dif_otp_ctrl_get_status(otp, status) == kDifOk &&
+          bitfield_bit32_read(status->codes, kDifOtpCtrlStatusCodeDaiIdle),
+      kOtpDaiTimeoutUs);
+  return OK_STATUS();
+}
+
+status_t otp_ctrl_testutils_dai_write_range(const dif_otp_ctrl_t *otp,
+                                            dif_otp_ctrl_partition_t partition,
+                                            uint32_t start_address,
+                                            const uint32_t *buffer, size_t len,
+                                            bool *word_failed) {
+  enum {
+    /**
+     * Number of 32bit words read at once. Must be a multiple of 2 to keep 64bit
+     * words together.
+     */
+    kChunkWordCount = 16,
+  };
+  bool is_secret = partition == kDifOtpCtrlPartitionSecret0 ||
+                   partition == kDifOtpCtrlPartitionSecret1 ||
+                   partition == kDifOtpCtrlPartitionSecret2;
+  size_t words_per_op = is_secret ? 2 : 1;
+  if (len % words_per_op != 0) {
+    return INVALID_ARGUMENT();
+  }
+
+  bool found_error = false;
+  TRY(otp_ctrl_testutils_wait_for_dai(otp));
+  for (size_t base = 0; base < len; base += kChunkWordCount) {
+    size_t count = len - base;
+    if (count > kChunkWordCount) {
+      count = kChunkWordCount;
+    }
+    uint32_t chunk_address = start_address + base * sizeof(uint32_t);
+    const uint32_t *expected = &buffer[base];
+    uint32_t current[kChunkWordCount];
+    TRY(dif_otp_ctrl_read_range_blocking(otp, partition, chunk_address,
+                                         current, count));
+
+    bool chunk_failed[kChunkWordCount] = {false};
+    bool programmed = false;
+    for (size_t i = 0; i < count; i += words_per_op) {
+      if (current[i] == expected[i] &&
+          (!is_secret || current[i + 1] == expected[i + 1])) {
+        continue;
+      }
+      uint32_t address = chunk_address + i * sizeof(uint32_t);
+      if (is_secret) {
+        uint64_t value = ((uint64_t)expected[i + 1] << 32) | expected[i];
+        TRY(dif_otp_ctrl_dai_program64(otp, partition, address, value));
+      } else {
+        TRY(dif_otp_ctrl_dai_program32(otp, partition, address, expected[i]));
+      }
+      dif_otp_ctrl_status_t status;
+      TRY(dai_wait_status(otp, &status));
+      if (bitfield_bit32_read(status.codes, kDifOtpCtrlStatusCodeDaiError)) {
+        LOG_ERROR("DAI program error at 0x%x: %d", address,
+                  status.causes[kDifOtpCtrlStatusCodeDaiError]);
+        chunk_failed[i] = true;
+      }
+      programmed = true;
+    }
+
+    if (programmed) {
+      TRY(dif_otp_ctrl_read_range_blocking(otp, partition, chunk_address,
+                                           current, count));
+    }
+    for (size_t i = 0; i < count; i += words_per_op) {
+      bool failed = chunk_failed[i] || current[i] != expected[i] ||
+                    (is_secret && current[i + 1] != expected[i + 1]);
+      found_error |= failed;
+      if (word_failed != NULL) {
+        word_failed[base + i] = failed;
+        if (is_secret) {
+          word_failed[base + i + 1] = failed;
+        }
+      }
+    }
+  }
+
+  return found_error ? INTERNAL() : OK_STATUS();
+}
@@ -105,4 +105,42 @@ status_t otp_ctrl_testutils_dai_write64(const dif_otp_ctrl_t *otp,
                                         uint32_t start_address,
                                         const uint64_t *buffer, size_t len);
 
+/**
+ * Programs `len` 32bit words from `buffer` into otp `partition` starting at
+ * `start_address` using the DAI interface.
+ *
+ * Unlike `otp_ctrl_testutils_dai_write32()` and
+ * `otp_ctrl_testutils_dai_write64()`, this function reads the current contents
+ * of the range first and skips words that already hold the expected value. The
+ * remaining words are programmed back to back. The DAI status is polled until
+ * each word completes, and the error bit is taken from that last poll instead
+ * of a separate status read. The range is read back in bulk at the end.
+ * Programming continues after a failed word so that all failures are reported
+ * in one pass.
+ *
+ * For secret partitions, each 64bit word is taken from two consecutive
+ * elements of `buffer`, least significant word first, and `start_address` and
+ * `len` must be 64bit aligned.
+ *
+ * This function does not lock the partition. Use
+ * `otp_ctrl_testutils_lock_partition()` once all of its fields are programmed.
+ *
+ * @param otp otp_ctrl instance.
+ * @param partition OTP partition.
+ * @param start_address Address relative to the start of the `partition`.
+ * @param buffer The buffer containing the data to be written into OTP.
+ * @param len The number of 32bit words to write into otp.
+ * @param[out] word_failed Optional array of `len` flags. Each flag is set to
+ * true if the corresponding word could not be programmed, false otherwise. For
+ * secret partitions, both flags of a failed 64bit word are set.
+ * @return OK_STATUS if all words hold the expected values, INTERNAL if any of
+ * them does not.
+ */
+OT_WARN_UNUSED_RESULT
+status_t otp_ctrl_testutils_dai_write_range(const dif_otp_ctrl_t *otp,
+                                            dif_otp_ctrl_partition_t partition,
+                                            uint32_t start_address,
+                                            const uint32_t *buffer, size_t len,
+                                            bool *word_failed);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_OTP_CTRL_TESTUTILS_H_
@@ -0,0 +1,403 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/spi_host_async.h"
+
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/dif/dif_spi_host.h"
+
+#include "spi_host_regs.h"  // Generated.
+
+enum {
+  /**
+   * Events managed by the asynchronous transaction engine.
+   */
+  kAsyncEvents = kDifSpiHostEvtRxWm | kDifSpiHostEvtTxWm |
+                 kDifSpiHostEvtReady | kDifSpiHostEvtIdle,
+  /**
+   * Maximum number of bytes or cycles of a single command.
+   */
+  kAsyncMaxCommandLength = SPI_HOST_COMMAND_LEN_MASK + 1,
+};
+
+/**
+ * Returns the number of bytes a segment moves through the FIFOs or, for dummy
+ * segments, the number of cycles.
+ */
+static size_t segment_length(const dif_spi_host_segment_t *segment) {
+  switch (segment->type) {
+    case kDifSpiHostSegmentTypeOpcode:
+      return 1;
+    case kDifSpiHostSegmentTypeAddress:
+      return segment->address.mode == kDifSpiHostAddrMode4b ? 4 : 3;
+    case kDifSpiHostSegmentTypeDummy:
+      return segment->dummy.length;
+    case kDifSpiHostSegmentTypeTx:
+      return segment->tx.length;
+    case kDifSpiHostSegmentTypeRx:
+      return segment->rx.length;
+    case kDifSpiHostSegmentTypeBidirectional:
+      return segment->bidir.length;
+    default:
+      return 0;
+  }
+}
+
+static void cursor_start(spi_host_async_cursor_t *cursor,
+                         spi_host_async_txn_t *txn) {
+  if (cursor->txn == NULL) {
+    cursor->txn = txn;
+    cursor->segment = 0;
+    cursor->offset = 0;
+  }
+}
+
+static void cursor_advance(spi_host_async_cursor_t *cursor) {
+  cursor->offset = 0;
+  if (++cursor->segment == cursor->txn->length) {
+    cursor->txn = cursor->txn->next;
+    cursor->segment = 0;
+  }
+}
+
+static dif_spi_host_segment_t *cursor_segment(
+    const spi_host_async_cursor_t *cursor) {
+  return &cursor->txn->segments[cursor->segment];
+}
+
+/**
+ * Returns how many bytes of a `len` byte buffer fit in `space` transmit FIFO
+ * entries.
+ *
+ * `dif_spi_host_fifo_write_burst()` writes whole words to one entry each and
+ * trailing bytes to one entry per byte, so a buffer that does not fit is cut
+ * down to whole words.
+ */
+static size_t tx_fifo_fit(size_t len, uint32_t space) {
+  size_t words = len / sizeof(uint32_t);
+  if (words + len % sizeof(uint32_t) <= space) {
+    return len;
+  }
+  return (words < space ? words : space) * sizeof(uint32_t);
+}
+
+/**
+ * Accounts for the commands that have finished since the last call.
+ *
+ * Commands finish in order, so they are attributed to the oldest transactions
+ * with commands in flight.
+ */
+static void async_retire(spi_host_async_t *async,
+                         const dif_spi_host_status_t *status) {
+  uint32_t pending = status->cmd_queue_depth + status->active;
+  if (pending >= async->cmds_in_flight) {
+    return;
+  }
+  uint32_t retired = async->cmds_in_flight - pending;
+  async->cmds_in_flight = pending;
+  for (spi_host_async_txn_t *txn = async->head; txn != NULL && retired > 0;
+       txn = txn->next) {
+    uint32_t count =
+        txn->cmds_in_flight < retired ? txn->cmds_in_flight : retired;
+    txn->cmds_in_flight -= count;
+    retired -= count;
+  }
+}
+
+/**
+ * Copies the words in the receive FIFO to the segment buffers.
+ *
+ * The data of each segment starts with a new word in the receive FIFO.
+ */
+static status_t async_rx(spi_host_async_t *async,
+                         const dif_spi_host_status_t *status) {
+  size_t available = status->rx_queue_depth * sizeof(uint32_t);
+  spi_host_async_cursor_t *rx = &async->rx;
+  while (rx->txn != NULL) {
+    dif_spi_host_segment_t *segment = cursor_segment(rx);
+    uint8_t *buf;
+    if (segment->type == kDifSpiHostSegmentTypeRx) {
+      buf = (uint8_t *)segment->rx.buf;
+    } else if (segment->type == kDifSpiHostSegmentTypeBidirectional) {
+      buf = (uint8_t *)segment->bidir.rxbuf;
+    } else {
+      cursor_advance(rx);
+      continue;
+    }
+    // Reading at most `available` bytes never waits for data. A trailing
+    // partial word still takes up a whole word in the FIFO.
+    size_t len = segment_length(segment) - rx->offset;
+    if (len > available) {
+      len = available;
+    }
+    if (len == 0) {
+      return OK_STATUS();
+    }
+    TRY(dif_spi_host_fifo_read_burst(async->spi_host, buf + rx->offset,
+                                     (uint16_t)len));
+    available -= (len + sizeof(uint32_t) - 1) / sizeof(uint32_t) *
+                 sizeof(uint32_t);
+    rx->offset += len;
+    if (rx->offset < segment_length(segment)) {
+      return OK_STATUS();
+    }
+    cursor_advance(rx);
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Writes as much of the queued transmit data as fits in the transmit FIFO.
+ */
+static status_t async_tx(spi_host_async_t *async,
+                         const dif_spi_host_status_t *status) {
+  uint32_t space = SPI_HOST_PARAM_TX_DEPTH - status->tx_queue_depth;
+  spi_host_async_cursor_t *tx = &async->tx;
+  while (tx->txn != NULL) {
+    dif_spi_host_segment_t *segment = cursor_segment(tx);
+    // The address appears on the wire in big-endian order.
+    uint32_t address;
+    const uint8_t *buf;
+    switch (segment->type) {
+      case kDifSpiHostSegmentTypeOpcode:
+        buf = &segment->opcode;
+        break;
+      case kDifSpiHostSegmentTypeAddress:
+        address = bitfield_byteswap32(segment->address.address);
+        if (segment->address.mode != kDifSpiHostAddrMode4b) {
+          address >>= 8;
+        }
+        buf = (const uint8_t *)&address;
+        break;
+      case kDifSpiHostSegmentTypeTx:
+        buf = (const uint8_t *)segment->tx.buf;
+        break;
+      case kDifSpiHostSegmentTypeBidirectional:
+        buf = (const uint8_t *)segment->bidir.txbuf;
+        break;
+      default:
+        cursor_advance(tx);
+        continue;
+    }
+    size_t len = tx_fifo_fit(segment_length(segment) - tx->offset, space);
+    if (len == 0) {
+      return OK_STATUS();
+    }
+    TRY(dif_spi_host_fifo_write_burst(async->spi_host, buf + tx->offset,
+                                      (uint16_t)len));
+    space -= (uint32_t)(len / sizeof(uint32_t) + len % sizeof(uint32_t));
+    tx->offset += len;
+    if (tx->offset < segment_length(segment)) {
+      return OK_STATUS();
+    }
+    cursor_advance(tx);
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Writes as many queued segments as fit in the command FIFO.
+ *
+ * Commands may run ahead of their transmit data, the SPI Host stalls until the
+ * data is available.
+ */
+static status_t async_cmd(spi_host_async_t *async,
+                          const dif_spi_host_status_t *status) {
+  uint32_t space = SPI_HOST_PARAM_CMD_DEPTH - status->cmd_queue_depth;
+  spi_host_async_cursor_t *cmd = &async->cmd;
+  while (cmd->txn != NULL && space > 0) {
+    spi_host_async_txn_t *txn = cmd->txn;
+    dif_spi_host_segment_t *segment = cursor_segment(cmd);
+    bool last_segment = cmd->segment == txn->length - 1;
+    if (cmd->segment == 0) {
+      TRY(dif_spi_host_set_csid(async->spi_host, txn->csid));
+    }
+    size_t length = segment_length(segment);
+    dif_spi_host_width_t width = kDifSpiHostWidthStandard;
+    dif_spi_host_direction_t direction = kDifSpiHostDirectionTx;
+    switch (segment->type) {
+      case kDifSpiHostSegmentTypeAddress:
+        width = segment->address.width;
+        break;
+      case kDifSpiHostSegmentTypeDummy:
+        width = segment->dummy.width;
+        direction = kDifSpiHostDirectionDummy;
+        break;
+      case kDifSpiHostSegmentTypeTx:
+        width = segment->tx.width;
+        break;
+      case kDifSpiHostSegmentTypeRx:
+        width = segment->rx.width;
+        direction = kDifSpiHostDirectionRx;
+        break;
+      case kDifSpiHostSegmentTypeBidirectional:
+        width = segment->bidir.width;
+        direction = kDifSpiHostDirectionBidirectional;
+        break;
+      default:
+        break;
+    }
+    // Zero-length dummy segments are skipped, the hardware would interpret
+    // them as 512 cycles.
+    if (length > 0) {
+      TRY(dif_spi_host_write_command(async->spi_host, (uint16_t)length, width,
+                                     direction, last_segment));
+      ++txn->cmds_in_flight;
+      ++async->cmds_in_flight;
+      --space;
+    }
+    cursor_advance(cmd);
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Invokes the callbacks of the completed transactions at the head of the
+ * queue.
+ */
+static void async_complete(spi_host_async_t *async) {
+  while (async->head != NULL) {
+    spi_host_async_txn_t *txn = async->head;
+    if (async->cmd.txn == txn || async->tx.txn == txn ||
+        async->rx.txn == txn || txn->cmds_in_flight > 0) {
+      return;
+    }
+    async->head = txn->next;
+    if (async->head == NULL) {
+      async->tail = NULL;
+    }
+    txn->next = NULL;
+    if (txn->callback != NULL) {
+      txn->callback(txn->arg, txn);
+    }
+  }
+}
+
+/**
+ * Enables the events needed to make progress with the queued transactions.
+ */
+static status_t async_events_update(spi_host_async_t *async) {
+  dif_spi_host_events_t events = 0;
+  if (async->cmd.txn != NULL) {
+    events |= kDifSpiHostEvtReady;
+  }
+  if (async->tx.txn != NULL) {
+    events |= kDifSpiHostEvtTxWm;
+  }
+  if (async->rx.txn != NULL) {
+    events |= kDifSpiHostEvtRxWm;
+  }
+  if (async->head != NULL) {
+    // Catches receive data below the watermark and the end of transactions
+    // without receive data.
+    events |= kDifSpiHostEvtIdle;
+  }
+  if (events == async->events) {
+    return OK_STATUS();
+  }
+  dif_spi_host_events_t disable = async->events & ~events;
+  dif_spi_host_events_t enable = events & ~async->events;
+  if (disable != 0) {
+    TRY(dif_spi_host_event_set_enabled(async->spi_host, disable, false));
+  }
+  if (enable != 0) {
+    TRY(dif_spi_host_event_set_enabled(async->spi_host, enable, true));
+  }
+  async->events = events;
+  return OK_STATUS();
+}
+
+status_t spi_host_async_init(const dif_spi_host_t *spi_host,
+                             spi_host_async_t *async) {
+  if (spi_host == NULL || async == NULL) {
+    return INVALID_ARGUMENT();
+  }
+
+  *async = (spi_host_async_t){
+      .spi_host = spi_host,
+  };
+  // Start from a known state of the events managed by the engine.
+  TRY(dif_spi_host_event_set_enabled(spi_host, kAsyncEvents, false));
+  return OK_STATUS();
+}
+
+status_t spi_host_async_enqueue(spi_host_async_t *async,
+                                spi_host_async_txn_t *txn) {
+  if (async == NULL || txn == NULL || txn->segments == NULL ||
+      txn->length == 0) {
+    return INVALID_ARGUMENT();
+  }
+  for (size_t i = 0; i < txn->length; ++i) {
+    dif_spi_host_segment_t *segment = &txn->segments[i];
+    size_t length = segment_length(segment);
+    if (segment->type > kDifSpiHostSegmentTypeBidirectional ||
+        length > kAsyncMaxCommandLength ||
+        (length == 0 && segment->type != kDifSpiHostSegmentTypeDummy)) {
+      return INVALID_ARGUMENT();
+    }
+  }
+
+  txn->next = NULL;
+  txn->cmds_in_flight = 0;
+  if (async->tail == NULL) {
+    async->head = txn;
+  } else {
+    async->tail->next = txn;
+  }
+  async->tail = txn;
+  cursor_start(&async->cmd, txn);
+  cursor_start(&async->tx, txn);
+  cursor_start(&async->rx, txn);
+
+  // Transactions enqueued from a completion callback are picked up by the
+  // running service loop.
+  if (async->in_service) {
+    return OK_STATUS();
+  }
+  return spi_host_async_service(async);
+}
+
+/**
+ * Runs one pass of the service loop.
+ *
+ * @param async The engine state.
+ * @param[out] again Whether another pass is needed.
+ * @return The result of the operation.
+ */
+static status_t async_service_once(spi_host_async_t *async, bool *again) {
+  dif_spi_host_status_t status;
+  TRY(dif_spi_host_get_status(async->spi_host, &status));
+  async_retire(async, &status);
+  TRY(async_rx(async, &status));
+  TRY(async_tx(async, &status));
+  TRY(async_cmd(async, &status));
+  async_complete(async);
+  TRY(async_events_update(async));
+
+  // READY and IDLE only raise an event on a transition, so go around again
+  // if the transition may have happened before the event was enabled.
+  TRY(dif_spi_host_get_status(async->spi_host, &status));
+  *again = (async->cmd.txn != NULL && status.ready) ||
+           (async->head != NULL && !status.active);
+  return OK_STATUS();
+}
+
+status_t spi_host_async_service(spi_host_async_t *async) {
+  if (async == NULL) {
+    return INVALID_ARGUMENT();
+  }
+
+  async->in_service = true;
+  status_t result;
+  bool again;
+  do {
+    result = async_service_once(async, &again);
+  } while (status_ok(result) && again);
+  async->in_service = false;
+  return result;
+}
+
+bool spi_host_async_is_idle(const spi_host_async_t *async) {
+  return async->head == NULL;
+}
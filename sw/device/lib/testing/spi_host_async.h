@@ -0,0 +1,148 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_SPI_HOST_ASYNC_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_SPI_HOST_ASYNC_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/dif/dif_spi_host.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * A SPI Host transaction for the asynchronous transaction engine.
+ *
+ * The transaction, its segments and their buffers must stay valid until the
+ * completion callback has been invoked.
+ */
+typedef struct spi_host_async_txn {
+  /** The chip-select ID of the SPI target. */
+  uint32_t csid;
+  /** The SPI segments to send in this transaction. */
+  dif_spi_host_segment_t *segments;
+  /** The number of SPI segments in this transaction. */
+  size_t length;
+  /**
+   * Invoked once all segments of the transaction have been executed and all
+   * received data has been copied out of the receive FIFO. May be `NULL`.
+   *
+   * The callback runs in the context of `spi_host_async_service()` and may
+   * enqueue further transactions.
+   */
+  void (*callback)(void *arg, struct spi_host_async_txn *txn);
+  /** Argument passed to `callback`. */
+  void *arg;
+  /** Next transaction in the queue, managed by the engine. */
+  struct spi_host_async_txn *next;
+  /** Issued commands that have not finished yet, managed by the engine. */
+  uint32_t cmds_in_flight;
+} spi_host_async_txn_t;
+
+/**
+ * Position of the asynchronous transaction engine in the queued segments.
+ */
+typedef struct spi_host_async_cursor {
+  /** Current transaction, `NULL` if all queued segments have been handled. */
+  spi_host_async_txn_t *txn;
+  /** Index of the current segment in `txn`. */
+  size_t segment;
+  /** Number of bytes of the current segment that have been handled. */
+  size_t offset;
+} spi_host_async_cursor_t;
+
+/**
+ * State of the asynchronous transaction engine.
+ *
+ * The engine keeps the command, transmit and receive FIFOs busy with segments
+ * from any number of queued transactions so that the bus does not idle
+ * between segments. It makes progress whenever `spi_host_async_service()` is
+ * called, which is normally done from the `kDifSpiHostIrqSpiEvent` interrupt
+ * handler; the engine enables the events it needs by itself.
+ *
+ * All members are private to the engine.
+ */
+typedef struct spi_host_async {
+  /** The SPI Host handle. */
+  const dif_spi_host_t *spi_host;
+  /** Oldest transaction that has not completed yet. */
+  spi_host_async_txn_t *head;
+  /** Most recently enqueued transaction. */
+  spi_host_async_txn_t *tail;
+  /** Next segment to write to the command FIFO. */
+  spi_host_async_cursor_t cmd;
+  /** Next segment to write to the transmit FIFO. */
+  spi_host_async_cursor_t tx;
+  /** Next segment to read from the receive FIFO. */
+  spi_host_async_cursor_t rx;
+  /** Commands written to the command FIFO that have not finished yet. */
+  uint32_t cmds_in_flight;
+  /** Events currently enabled by the engine. */
+  dif_spi_host_events_t events;
+  /** Whether `spi_host_async_service()` is running. */
+  bool in_service;
+} spi_host_async_t;
+
+/**
+ * Initializes the asynchronous transaction engine.
+ *
+ * The SPI Host must have been configured and must not be used through
+ * `dif_spi_host_transaction()` while transactions are queued.
+ *
+ * @param spi_host A SPI Host handle, must outlive `async`.
+ * @param[out] async The engine state.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t spi_host_async_init(const dif_spi_host_t *spi_host,
+                             spi_host_async_t *async);
+
+/**
+ * Queues a transaction and starts it as soon as there is room in the FIFOs.
+ *
+ * Transactions are executed in the order they are enqueued, back to back. This
+ * function must not race with `spi_host_async_service()`: when called outside
+ * of a completion callback, the `kDifSpiHostIrqSpiEvent` interrupt must be
+ * masked.
+ *
+ * @param async The engine state.
+ * @param txn The transaction to queue.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t spi_host_async_enqueue(spi_host_async_t *async,
+                                spi_host_async_txn_t *txn);
+
+/**
+ * Moves queued transactions forward and completes finished ones.
+ *
+ * Fills the command and transmit FIFOs, drains the receive FIFO and invokes
+ * the callbacks of completed transactions. Should be called from the
+ * `kDifSpiHostIrqSpiEvent` interrupt handler after acknowledging the
+ * interrupt, but may also be polled.
+ *
+ * @param async The engine state.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t spi_host_async_service(spi_host_async_t *async);
+
+/**
+ * Checks whether all queued transactions have completed.
+ *
+ * @param async The engine state.
+ * @return True if there are no queued transactions, false otherwise.
+ */
+bool spi_host_async_is_idle(const spi_host_async_t *async);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_SPI_HOST_ASYNC_H_
@@ -0,0 +1,489 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/spi_host_async.h"
+
+#include <deque>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/base/mock_mmio_regfile.h"
+
+#include "spi_host_regs.h"  // Generated.
+
+namespace spi_host_async_unittest {
+namespace {
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::Test;
+
+/**
+ * A command as written to the COMMAND register.
+ */
+struct Command {
+  uint32_t csid;
+  uint32_t length;
+  uint32_t speed;
+  uint32_t direction;
+  bool csaat;
+  uint32_t done;
+};
+
+/**
+ * Behavioural model of the SPI Host command, transmit and receive FIFOs.
+ *
+ * The model executes up to `step_bytes` bytes of the queued commands before
+ * each read of the STATUS register, stalling when it runs out of transmit data
+ * or receive FIFO space. Each receive segment starts with a new word in the
+ * receive FIFO.
+ */
+class SpiHostModel : public mock_mmio::RegisterFileDevice {
+ public:
+  SpiHostModel() {
+    Ro(SPI_HOST_STATUS_REG_OFFSET);
+    Rw(SPI_HOST_EVENT_ENABLE_REG_OFFSET);
+    Rw(SPI_HOST_CSID_REG_OFFSET);
+    Rw(SPI_HOST_COMMAND_REG_OFFSET);
+    Fifo(SPI_HOST_RXDATA_REG_OFFSET);
+    OnRead(SPI_HOST_STATUS_REG_OFFSET, [this] {
+      Step();
+      UpdateStatus();
+    });
+    OnWrite(SPI_HOST_COMMAND_REG_OFFSET, [this](uint32_t value) {
+      EXPECT_LT(CmdQueueDepth(), SPI_HOST_PARAM_CMD_DEPTH);
+      commands_.push_back({
+          .csid = Get(SPI_HOST_CSID_REG_OFFSET),
+          .length =
+              bitfield_field32_read(value, SPI_HOST_COMMAND_LEN_FIELD) + 1,
+          .speed = bitfield_field32_read(value, SPI_HOST_COMMAND_SPEED_FIELD),
+          .direction =
+              bitfield_field32_read(value, SPI_HOST_COMMAND_DIRECTION_FIELD),
+          .csaat = bitfield_bit32_read(value, SPI_HOST_COMMAND_CSAAT_BIT),
+          .done = 0,
+      });
+      UpdateStatus();
+    });
+  }
+
+  // The transmit FIFO keeps the width of each write, which decides how many
+  // bytes the entry holds.
+  void Write8(ptrdiff_t offset, uint8_t value) override {
+    if (offset != SPI_HOST_TXDATA_REG_OFFSET) {
+      RegisterFileDevice::Write8(offset, value);
+      return;
+    }
+    tx_fifo_.push_back({value});
+    EXPECT_LE(tx_fifo_.size(), SPI_HOST_PARAM_TX_DEPTH);
+  }
+
+  void Write32(ptrdiff_t offset, uint32_t value) override {
+    if (offset != SPI_HOST_TXDATA_REG_OFFSET) {
+      RegisterFileDevice::Write32(offset, value);
+      return;
+    }
+    tx_fifo_.push_back({static_cast<uint8_t>(value),
+                        static_cast<uint8_t>(value >> 8),
+                        static_cast<uint8_t>(value >> 16),
+                        static_cast<uint8_t>(value >> 24)});
+    EXPECT_LE(tx_fifo_.size(), SPI_HOST_PARAM_TX_DEPTH);
+  }
+
+  /**
+   * Executes queued commands for up to `step_bytes` bytes or cycles.
+   */
+  void Step() {
+    uint32_t budget = step_bytes;
+    auto &rx_fifo = FifoData(SPI_HOST_RXDATA_REG_OFFSET);
+    while (!commands_.empty() && budget > 0) {
+      Command &cmd = commands_.front();
+      bool tx = cmd.direction == 2 || cmd.direction == 3;
+      bool rx = cmd.direction == 1 || cmd.direction == 3;
+      while (cmd.done < cmd.length && budget > 0) {
+        if (tx && tx_fifo_.empty()) {
+          return;
+        }
+        if (rx && rx_fifo.size() == SPI_HOST_PARAM_RX_DEPTH) {
+          return;
+        }
+        if (tx) {
+          wire.push_back(tx_fifo_.front().front());
+          tx_fifo_.front().pop_front();
+          if (tx_fifo_.front().empty()) {
+            tx_fifo_.pop_front();
+          }
+        }
+        if (rx) {
+          EXPECT_FALSE(to_receive.empty());
+          uint8_t byte = to_receive.empty() ? 0 : to_receive.front();
+          if (!to_receive.empty()) {
+            to_receive.pop_front();
+          }
+          rx_word_ |= static_cast<uint32_t>(byte) << (8 * rx_bytes_);
+          if (++rx_bytes_ == sizeof(uint32_t)) {
+            rx_fifo.push_back(rx_word_);
+            rx_word_ = 0;
+            rx_bytes_ = 0;
+          }
+        }
+        ++cmd.done;
+        --budget;
+      }
+      if (cmd.done < cmd.length) {
+        return;
+      }
+      if (rx_bytes_ > 0) {
+        rx_fifo.push_back(rx_word_);
+        rx_word_ = 0;
+        rx_bytes_ = 0;
+      }
+      executed.push_back(cmd);
+      commands_.pop_front();
+    }
+  }
+
+  /**
+   * Returns the number of commands waiting behind the active one.
+   */
+  uint32_t CmdQueueDepth() const {
+    return commands_.empty() ? 0 : static_cast<uint32_t>(commands_.size() - 1);
+  }
+
+  void UpdateStatus() {
+    uint32_t reg = 0;
+    reg = bitfield_bit32_write(reg, SPI_HOST_STATUS_READY_BIT,
+                               CmdQueueDepth() < SPI_HOST_PARAM_CMD_DEPTH);
+    reg = bitfield_bit32_write(reg, SPI_HOST_STATUS_ACTIVE_BIT,
+                               !commands_.empty());
+    reg = bitfield_field32_write(reg, SPI_HOST_STATUS_TXQD_FIELD,
+                                 tx_fifo_.size());
+    reg = bitfield_field32_write(reg, SPI_HOST_STATUS_RXQD_FIELD,
+                                 FifoData(SPI_HOST_RXDATA_REG_OFFSET).size());
+    reg = bitfield_field32_write(reg, SPI_HOST_STATUS_CMDQD_FIELD,
+                                 CmdQueueDepth());
+    Set(SPI_HOST_STATUS_REG_OFFSET, reg);
+  }
+
+  /** Bytes or cycles executed per STATUS read, zero to hold the bus. */
+  uint32_t step_bytes = 8;
+  /** Bytes to shift in during receive segments. */
+  std::deque<uint8_t> to_receive;
+  /** Bytes shifted out during transmit segments. */
+  std::vector<uint8_t> wire;
+  /** Commands that have finished. */
+  std::vector<Command> executed;
+
+ private:
+  std::deque<Command> commands_;
+  std::deque<std::deque<uint8_t>> tx_fifo_;
+  uint32_t rx_word_ = 0;
+  uint32_t rx_bytes_ = 0;
+};
+
+class AsyncTest : public Test {
+ protected:
+  AsyncTest() {
+    EXPECT_TRUE(status_ok(spi_host_async_init(&spi_host_, &async_)));
+  }
+
+  /**
+   * Services the engine until it is idle, as the event interrupt handler
+   * would.
+   */
+  void Drive() {
+    for (size_t i = 0; i < 10000 && !spi_host_async_is_idle(&async_); ++i) {
+      // An engine that waits with all events disabled would never be called
+      // again.
+      EXPECT_NE(dev_.Get(SPI_HOST_EVENT_ENABLE_REG_OFFSET), 0);
+      EXPECT_TRUE(status_ok(spi_host_async_service(&async_)));
+    }
+    EXPECT_TRUE(spi_host_async_is_idle(&async_));
+    EXPECT_EQ(dev_.Get(SPI_HOST_EVENT_ENABLE_REG_OFFSET), 0);
+  }
+
+  static void Done(void *arg, spi_host_async_txn_t *txn) {
+    static_cast<std::vector<spi_host_async_txn_t *> *>(arg)->push_back(txn);
+  }
+
+  SpiHostModel dev_;
+  dif_spi_host_t spi_host_ = {.base_addr = dev_.region()};
+  spi_host_async_t async_;
+  std::vector<spi_host_async_txn_t *> done_;
+};
+
+TEST_F(AsyncTest, NullArgs) {
+  dif_spi_host_segment_t segment = {
+      .type = kDifSpiHostSegmentTypeOpcode,
+      .opcode = 0x06,
+  };
+  spi_host_async_txn_t txn = {.segments = &segment, .length = 1};
+
+  EXPECT_EQ(status_err(spi_host_async_init(nullptr, &async_)),
+            kInvalidArgument);
+  EXPECT_EQ(status_err(spi_host_async_init(&spi_host_, nullptr)),
+            kInvalidArgument);
+  EXPECT_EQ(status_err(spi_host_async_enqueue(nullptr, &txn)),
+            kInvalidArgument);
+  EXPECT_EQ(status_err(spi_host_async_enqueue(&async_, nullptr)),
+            kInvalidArgument);
+  EXPECT_EQ(status_err(spi_host_async_service(nullptr)), kInvalidArgument);
+}
+
+TEST_F(AsyncTest, BadSegments) {
+  uint8_t buf[4];
+  dif_spi_host_segment_t segment = {
+      .type = kDifSpiHostSegmentTypeTx,
+      .tx = {.width = kDifSpiHostWidthStandard, .buf = buf, .length = 0},
+  };
+  spi_host_async_txn_t txn = {.segments = &segment, .length = 1};
+  EXPECT_EQ(status_err(spi_host_async_enqueue(&async_, &txn)),
+            kInvalidArgument);
+
+  segment.type = kDifSpiHostSegmentTypeRx;
+  segment.rx = {.width = kDifSpiHostWidthStandard, .buf = buf, .length = 0};
+  EXPECT_EQ(status_err(spi_host_async_enqueue(&async_, &txn)),
+            kInvalidArgument);
+
+  segment.rx.length = SPI_HOST_COMMAND_LEN_MASK + 2;
+  EXPECT_EQ(status_err(spi_host_async_enqueue(&async_, &txn)),
+            kInvalidArgument);
+
+  txn.length = 0;
+  EXPECT_EQ(status_err(spi_host_async_enqueue(&async_, &txn)),
+            kInvalidArgument);
+
+  EXPECT_TRUE(spi_host_async_is_idle(&async_));
+  EXPECT_EQ(dev_.Writes(SPI_HOST_COMMAND_REG_OFFSET), 0);
+}
+
+TEST_F(AsyncTest, OpcodeRead) {
+  uint8_t buf[3] = {};
+  dif_spi_host_segment_t segments[] = {
+      {.type = kDifSpiHostSegmentTypeOpcode, .opcode = 0x9f},
+      {.type = kDifSpiHostSegmentTypeRx,
+       .rx = {.width = kDifSpiHostWidthDual, .buf = buf, .length = 3}},
+  };
+  spi_host_async_txn_t txn = {
+      .csid = 1,
+      .segments = segments,
+      .length = 2,
+      .callback = Done,
+      .arg = &done_,
+  };
+  dev_.to_receive = {0x11, 0x22, 0x33};
+
+  EXPECT_TRUE(status_ok(spi_host_async_enqueue(&async_, &txn)));
+  Drive();
+
+  EXPECT_THAT(buf, ElementsAre(0x11, 0x22, 0x33));
+  EXPECT_THAT(dev_.wire, ElementsAre(0x9f));
+  EXPECT_THAT(done_, ElementsAre(&txn));
+  ASSERT_EQ(dev_.executed.size(), 2);
+  EXPECT_EQ(dev_.executed[0].csid, 1);
+  EXPECT_EQ(dev_.executed[0].length, 1);
+  EXPECT_EQ(dev_.executed[0].direction, 2);
+  EXPECT_TRUE(dev_.executed[0].csaat);
+  EXPECT_EQ(dev_.executed[1].csid, 1);
+  EXPECT_EQ(dev_.executed[1].length, 3);
+  EXPECT_EQ(dev_.executed[1].speed, 1);
+  EXPECT_EQ(dev_.executed[1].direction, 1);
+  EXPECT_FALSE(dev_.executed[1].csaat);
+}
+
+// Checks that the address goes out most significant byte first and that the
+// dummy cycles do not consume transmit data.
+TEST_F(AsyncTest, AddressDummyRead) {
+  uint8_t buf[5] = {};
+  dif_spi_host_segment_t segments[] = {
+      {.type = kDifSpiHostSegmentTypeOpcode, .opcode = 0x0b},
+      {.type = kDifSpiHostSegmentTypeAddress,
+       .address = {.width = kDifSpiHostWidthStandard,
+                   .mode = kDifSpiHostAddrMode3b,
+                   .address = 0x123456}},
+      {.type = kDifSpiHostSegmentTypeDummy,
+       .dummy = {.width = kDifSpiHostWidthStandard, .length = 8}},
+      {.type = kDifSpiHostSegmentTypeRx,
+       .rx = {.width = kDifSpiHostWidthStandard, .buf = buf, .length = 5}},
+  };
+  spi_host_async_txn_t txn = {
+      .segments = segments,
+      .length = 4,
+      .callback = Done,
+      .arg = &done_,
+  };
+  dev_.to_receive = {1, 2, 3, 4, 5};
+
+  EXPECT_TRUE(status_ok(spi_host_async_enqueue(&async_, &txn)));
+  Drive();
+
+  EXPECT_THAT(dev_.wire, ElementsAre(0x0b, 0x12, 0x34, 0x56));
+  EXPECT_THAT(buf, ElementsAre(1, 2, 3, 4, 5));
+  EXPECT_THAT(done_, ElementsAre(&txn));
+  EXPECT_EQ(dev_.executed.size(), 4);
+}
+
+TEST_F(AsyncTest, BackToBack) {
+  uint8_t status = 0;
+  dif_spi_host_segment_t wren = {
+      .type = kDifSpiHostSegmentTypeOpcode,
+      .opcode = 0x06,
+  };
+  dif_spi_host_segment_t rdsr[] = {
+      {.type = kDifSpiHostSegmentTypeOpcode, .opcode = 0x05},
+      {.type = kDifSpiHostSegmentTypeRx,
+       .rx = {.width = kDifSpiHostWidthStandard, .buf = &status, .length = 1}},
+  };
+  spi_host_async_txn_t txn1 = {
+      .csid = 0,
+      .segments = &wren,
+      .length = 1,
+      .callback = Done,
+      .arg = &done_,
+  };
+  spi_host_async_txn_t txn2 = {
+      .csid = 2,
+      .segments = rdsr,
+      .length = 2,
+      .callback = Done,
+      .arg = &done_,
+  };
+  dev_.to_receive = {0xa5};
+
+  EXPECT_TRUE(status_ok(spi_host_async_enqueue(&async_, &txn1)));
+  EXPECT_TRUE(status_ok(spi_host_async_enqueue(&async_, &txn2)));
+  Drive();
+
+  EXPECT_EQ(status, 0xa5);
+  EXPECT_THAT(dev_.wire, ElementsAre(0x06, 0x05));
+  EXPECT_THAT(done_, ElementsAre(&txn1, &txn2));
+  ASSERT_EQ(dev_.executed.size(), 3);
+  EXPECT_EQ(dev_.executed[0].csid, 0);
+  EXPECT_FALSE(dev_.executed[0].csaat);
+  EXPECT_EQ(dev_.executed[1].csid, 2);
+  EXPECT_TRUE(dev_.executed[1].csaat);
+  EXPECT_EQ(dev_.executed[2].csid, 2);
+  EXPECT_FALSE(dev_.executed[2].csaat);
+}
+
+// Checks that the engine waits for the READY event when the command FIFO is
+// full and issues the remaining commands once the bus moves again.
+TEST_F(AsyncTest, CommandFifoFull) {
+  constexpr size_t kSegments = SPI_HOST_PARAM_CMD_DEPTH + 3;
+  uint8_t data[kSegments];
+  std::vector<dif_spi_host_segment_t> segments(kSegments);
+  for (size_t i = 0; i < kSegments; ++i) {
+    data[i] = static_cast<uint8_t>(i);
+    segments[i] = {
+        .type = kDifSpiHostSegmentTypeTx,
+        .tx = {.width = kDifSpiHostWidthStandard, .buf = &data[i], .length = 1},
+    };
+  }
+  spi_host_async_txn_t txn = {
+      .segments = segments.data(),
+      .length = kSegments,
+      .callback = Done,
+      .arg = &done_,
+  };
+
+  dev_.step_bytes = 0;
+  EXPECT_TRUE(status_ok(spi_host_async_enqueue(&async_, &txn)));
+  EXPECT_EQ(dev_.Writes(SPI_HOST_COMMAND_REG_OFFSET),
+            SPI_HOST_PARAM_CMD_DEPTH + 1);
+  EXPECT_TRUE(bitfield_bit32_read(dev_.Get(SPI_HOST_EVENT_ENABLE_REG_OFFSET),
+                                  SPI_HOST_EVENT_ENABLE_READY_BIT));
+  EXPECT_TRUE(done_.empty());
+
+  dev_.step_bytes = 1;
+  Drive();
+  EXPECT_EQ(dev_.Writes(SPI_HOST_COMMAND_REG_OFFSET), kSegments);
+  EXPECT_THAT(dev_.wire, ElementsAreArray(data));
+  EXPECT_THAT(done_, ElementsAre(&txn));
+}
+
+// Checks a transfer that is much larger than the FIFOs, from and to
+// misaligned buffers.
+TEST_F(AsyncTest, LargeTransfer) {
+  constexpr size_t kLength = SPI_HOST_COMMAND_LEN_MASK + 1;
+  std::vector<uint8_t> tx_buf(kLength + 1);
+  std::vector<uint8_t> rx_buf(kLength + 1);
+  std::vector<uint8_t> expected_rx(kLength);
+  for (size_t i = 0; i < kLength; ++i) {
+    tx_buf[i + 1] = static_cast<uint8_t>(i * 7);
+    expected_rx[i] = static_cast<uint8_t>(i * 13);
+  }
+  dev_.to_receive.assign(expected_rx.begin(), expected_rx.end());
+  dif_spi_host_segment_t segments[] = {
+      {.type = kDifSpiHostSegmentTypeTx,
+       .tx = {.width = kDifSpiHostWidthStandard,
+              .buf = tx_buf.data() + 1,
+              .length = kLength}},
+      {.type = kDifSpiHostSegmentTypeRx,
+       .rx = {.width = kDifSpiHostWidthStandard,
+              .buf = rx_buf.data() + 1,
+              .length = kLength}},
+  };
+  spi_host_async_txn_t txn = {
+      .segments = segments,
+      .length = 2,
+      .callback = Done,
+      .arg = &done_,
+  };
+
+  dev_.step_bytes = 64;
+  EXPECT_TRUE(status_ok(spi_host_async_enqueue(&async_, &txn)));
+  Drive();
+
+  EXPECT_THAT(dev_.wire, ElementsAreArray(tx_buf.begin() + 1, tx_buf.end()));
+  EXPECT_THAT(std::vector<uint8_t>(rx_buf.begin() + 1, rx_buf.end()),
+              ElementsAreArray(expected_rx));
+  EXPECT_THAT(done_, ElementsAre(&txn));
+}
+
+// Checks that a transaction enqueued from a completion callback is picked up
+// by the running service loop.
+TEST_F(AsyncTest, EnqueueFromCallback) {
+  struct Chain {
+    spi_host_async_t *async;
+    spi_host_async_txn_t *next;
+    std::vector<spi_host_async_txn_t *> *done;
+  };
+  dif_spi_host_segment_t wren = {
+      .type = kDifSpiHostSegmentTypeOpcode,
+      .opcode = 0x06,
+  };
+  dif_spi_host_segment_t wrdi = {
+      .type = kDifSpiHostSegmentTypeOpcode,
+      .opcode = 0x04,
+  };
+  spi_host_async_txn_t txn2 = {
+      .segments = &wrdi,
+      .length = 1,
+      .callback = Done,
+      .arg = &done_,
+  };
+  Chain chain = {.async = &async_, .next = &txn2, .done = &done_};
+  spi_host_async_txn_t txn1 = {
+      .segments = &wren,
+      .length = 1,
+      .callback =
+          [](void *arg, spi_host_async_txn_t *txn) {
+            auto *chain = static_cast<Chain *>(arg);
+            chain->done->push_back(txn);
+            EXPECT_TRUE(
+                status_ok(spi_host_async_enqueue(chain->async, chain->next)));
+          },
+      .arg = &chain,
+  };
+
+  EXPECT_TRUE(status_ok(spi_host_async_enqueue(&async_, &txn1)));
+  Drive();
+
+  EXPECT_THAT(dev_.wire, ElementsAre(0x06, 0x04));
+  EXPECT_THAT(done_, ElementsAre(&txn1, &txn2));
+}
+
+}  // namespace
+}  // namespace spi_host_async_unittest
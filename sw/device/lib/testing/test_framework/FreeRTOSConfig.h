@@ -11,10 +11,39 @@
 // NOTE: the macro names below do NOT, and cannot, conform to the style
 // guide, since they are specific to FreeRTOS.
 
+/**
+ * Selects the preemptive OTTF configuration.
+ *
+ * By default, OTTF tasks are scheduled cooperatively, and only switch on
+ * `ottf_task_yield()`. When `OTTF_PREEMPTIVE` is set (see the
+ * `--config=ottf_preemptive` Bazel configuration), the rv_timer drives the
+ * FreeRTOS tick, tasks of equal priority are time sliced, task notifications
+ * and mutexes are available, and the time spent in each task is accounted
+ * with `mcycle`, see `ottf_task_log_runtime_stats()`.
+ */
+#ifndef OTTF_PREEMPTIVE
+#define OTTF_PREEMPTIVE 0
+#endif
+
 // Debugging
-#define configGENERATE_RUN_TIME_STATS 0
 #define configUSE_APPLICATION_TASK_TAG 0
+#if OTTF_PREEMPTIVE
+#define configGENERATE_RUN_TIME_STATS 1
+#define configUSE_TRACE_FACILITY 1
+#define configUSE_STATS_FORMATTING_FUNCTIONS 0
+// The run-time stats counter is the low word of `mcycle`, which counts from
+// reset, so no setup is required. It wraps after 2^32 cycles, so stats are
+// only meaningful over shorter measurement windows.
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE() ottf_run_time_counter_value()
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+extern uint32_t ottf_run_time_counter_value(void);
+#endif  // __ASSEMBLER__
+#else
+#define configGENERATE_RUN_TIME_STATS 0
 #define configUSE_TRACE_FACILITY 0
+#endif  // OTTF_PREEMPTIVE
 
 // Hooks
 #define configUSE_IDLE_HOOK 0
@@ -33,15 +62,19 @@
 #define configENABLE_BACKWARD_COMPATIBILITY 0
 #define configMAX_TASK_NAME_LEN 16
 #define configQUEUE_REGISTRY_SIZE 0
-#define configUSE_TASK_NOTIFICATIONS 0
+#define configUSE_TASK_NOTIFICATIONS OTTF_PREEMPTIVE
 
 // Scheduler
 #define configIDLE_SHOULD_YIELD 0
 #define configMAX_PRIORITIES 5
+#if OTTF_PREEMPTIVE
+#define configTICK_RATE_HZ ((TickType_t)1000)  // 1ms tick rate
+#else
 #define configTICK_RATE_HZ ((TickType_t)10)  // 100ms tick rate
+#endif  // OTTF_PREEMPTIVE
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
-#define configUSE_PREEMPTION 0
-#define configUSE_TIME_SLICING 0
+#define configUSE_PREEMPTION OTTF_PREEMPTIVE
+#define configUSE_TIME_SLICING OTTF_PREEMPTIVE
 #define configUSE_16_BIT_TICKS 0
 
 // Software timers.
@@ -49,7 +82,7 @@
 
 // Synchronization
 #define configUSE_COUNTING_SEMAPHORES 0
-#define configUSE_MUTEXES 0
+#define configUSE_MUTEXES OTTF_PREEMPTIVE
 #define configUSE_RECURSIVE_MUTEXES 0
 
 // FreeRTOS API functions to include in build image.
@@ -3,10 +3,12 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "sw/device/lib/dif/dif_rv_timer.h"
+#include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/runtime/irq.h"
 #include "sw/device/lib/runtime/log.h"
 #include "sw/device/lib/testing/test_framework/FreeRTOSConfig.h"
 #include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_isrs.h"
 
 // TODO: make this toplevel agnostic.
 #include "external/freertos/include/FreeRTOS.h"
@@ -40,19 +42,29 @@ static const uint32_t kTimerComparatorId = 0;
 static const uint64_t kTimerDeadline =
     100;  // Counter must reach 100 for an IRQ to be triggered.
 
-// Override the timer ISR to support preemptive context switching.
-void ottf_timer_isr(void) {
-  LOG_INFO("Handling timer IQR ...");
+// Set once the rv_timer drives the scheduler tick.
+static bool tick_enabled = false;
+
+// Override the tick ISR to support preemptive context switching.
+bool ottf_tick_isr(void) {
+  if (!tick_enabled) {
+    return false;
+  }
   dif_rv_timer_irq_enable_snapshot_t irq_enable_snapshot;
   CHECK_DIF_OK(
       dif_rv_timer_irq_disable_all(&timer, kTimerHartId, &irq_enable_snapshot));
   CHECK_DIF_OK(dif_rv_timer_counter_write(&timer, kTimerHartId, 0));
   CHECK_DIF_OK(dif_rv_timer_irq_acknowledge(
       &timer, kDifRvTimerIrqTimerExpiredHart0Timer0));
-  // TODO: increment scheduler tick and switch context if necessary
+  // The OTTF ISR entry code has already saved the context of the interrupted
+  // task to its TCB, and the exit code restores the context of whichever task
+  // `pxCurrentTCB` points to, so switching tasks here is sufficient.
+  if (xTaskIncrementTick() != pdFALSE) {
+    vTaskSwitchContext();
+  }
   CHECK_DIF_OK(
       dif_rv_timer_irq_restore_all(&timer, kTimerHartId, &irq_enable_snapshot));
-  LOG_INFO("Done.");
+  return true;
 }
 
 void vPortSetupTimerInterrupt(void) {
@@ -79,12 +91,24 @@ void vPortSetupTimerInterrupt(void) {
   CHECK_DIF_OK(dif_rv_timer_arm(&timer, kTimerHartId, kTimerComparatorId,
                                 kTimerDeadline));
 
+  tick_enabled = true;
   CHECK_DIF_OK(dif_rv_timer_counter_set_enabled(&timer, kTimerHartId,
                                                 kDifToggleEnabled));
 }
 
 #endif  // configUSE_PREEMPTION
 
+// ----------------------------------------------------------------------------
+// Run-Time Stats Setup
+// ----------------------------------------------------------------------------
+#if configGENERATE_RUN_TIME_STATS
+
+uint32_t ottf_run_time_counter_value(void) {
+  return (uint32_t)ibex_mcycle_read();
+}
+
+#endif  // configGENERATE_RUN_TIME_STATS
+
 // ----------------------------------------------------------------------------
 // Scheduler Setup
 // ----------------------------------------------------------------------------
@@ -11,11 +11,22 @@
 #include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/runtime/log.h"
 #include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_macros.h"
 
 #include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
 
 dif_rv_plic_t ottf_plic;
 
+// Check layout of the IRQ timestamps struct since OTTF ISR asm code writes it
+// at fixed offsets.
+OT_ASSERT_MEMBER_OFFSET(ottf_isr_timestamps_t, entry,
+                        OTTF_ISR_TIMESTAMP_ENTRY);
+OT_ASSERT_MEMBER_OFFSET(ottf_isr_timestamps_t, handler,
+                        OTTF_ISR_TIMESTAMP_HANDLER);
+OT_ASSERT_MEMBER_OFFSET(ottf_isr_timestamps_t, exit, OTTF_ISR_TIMESTAMP_EXIT);
+
+volatile ottf_isr_timestamps_t ottf_isr_timestamps;
+
 // Fault reasons from
 // https://riscv.org/wp-content/uploads/2017/05/riscv-privileged-v1.10.pdf
 static const char *exception_reason[] = {
@@ -149,6 +160,9 @@ void ottf_timer_isr(void) {
   abort();
 }
 
+OT_WEAK
+bool ottf_tick_isr(void) { return false; }
+
 OT_WEAK
 bool ottf_console_flow_control_isr(void) { return false; }
 
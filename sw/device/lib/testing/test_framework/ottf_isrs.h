@@ -4,6 +4,7 @@
 
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_ISRS_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_ISRS_H_
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "sw/device/lib/dif/dif_rv_plic.h"
@@ -13,6 +14,41 @@
  */
 extern dif_rv_plic_t ottf_plic;
 
+/**
+ * Cycle timestamps of the last interrupt handled by the OTTF.
+ *
+ * These are only recorded when the OTTF is built with `OTTF_ISR_TIMESTAMPS`
+ * (see the `--config=ottf_isr_timestamps` Bazel configuration), and otherwise
+ * remain zero. Each timestamp is the low word of `mcycle`, so differences
+ * between them should be computed with unsigned 32-bit arithmetic.
+ *
+ * WARNING: DO NOT REARRANGE THE MEMBERS IN THIS STRUCT. THEY ARE WRITTEN BY
+ * OTTF ISR ASSEMBLY AT THE OFFSETS DEFINED IN ottf_macros.h.
+ */
+typedef struct ottf_isr_timestamps {
+  /**
+   * Taken on entry to the assembly IRQ handler, after the four instructions
+   * that make room for, and save, the registers used to take the timestamp.
+   */
+  uint32_t entry;
+  /**
+   * Taken after the context has been saved, just before calling the C IRQ
+   * handler, e.g. `ottf_external_isr()`.
+   */
+  uint32_t handler;
+  /**
+   * Taken after the C handler returns, before the context is restored.
+   *
+   * This is also recorded on return from exception handlers.
+   */
+  uint32_t exit;
+} ottf_isr_timestamps_t;
+
+/**
+ * OTTF IRQ timestamps, see `ottf_isr_timestamps_t`.
+ */
+extern volatile ottf_isr_timestamps_t ottf_isr_timestamps;
+
 /**
  * OTTF fault printing function.
  *
@@ -123,11 +159,29 @@ void ottf_software_isr(void);
 /**
  * OTTF timer IRQ handler.
  *
+ * Only called for timer IRQs that `ottf_tick_isr()` did not handle.
+ *
  * `ottf_isrs.c` provides a weak definition of this symbol, which can be
  * overriden at link-time by providing an additional non-weak definition.
  */
 void ottf_timer_isr(void);
 
+/**
+ * OTTF scheduler tick IRQ handler.
+ *
+ * Called on every timer IRQ before `ottf_timer_isr()`. In the preemptive OTTF
+ * configuration (see `OTTF_PREEMPTIVE` in FreeRTOSConfig.h), the rv_timer
+ * drives the FreeRTOS tick once the scheduler has started, and this function
+ * handles the IRQ. Tests that run without concurrency therefore keep the timer
+ * to themselves.
+ *
+ * `ottf_isrs.c` provides a weak definition of this symbol that handles
+ * nothing, which `freertos_port.c` overrides in the preemptive configuration.
+ *
+ * @return Whether the IRQ was handled.
+ */
+bool ottf_tick_isr(void);
+
 /**
  * OTTF external IRQ handler.
  *
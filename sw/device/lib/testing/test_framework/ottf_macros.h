@@ -9,6 +9,12 @@
 #define OTTF_NV_SCRATCH _non_volatile_scratch_start
 #define OTTF_HALF_WORD_SIZE (OTTF_WORD_SIZE / 2)
 #define OTTF_CONTEXT_SIZE (OTTF_WORD_SIZE * 30)
+
+// Offsets of the fields of `ottf_isr_timestamps_t`, see ottf_isrs.h.
+#define OTTF_ISR_TIMESTAMP_ENTRY 0
+#define OTTF_ISR_TIMESTAMP_HANDLER 4
+#define OTTF_ISR_TIMESTAMP_EXIT 8
+
 #define OTTF_TASK_DELETE_SELF_OR_DIE \
   ottf_task_delete_self();           \
   abort();
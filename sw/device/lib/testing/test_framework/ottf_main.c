@@ -77,6 +77,94 @@ char *ottf_task_get_self_name(void) {
   return pcTaskGetName(/*xTaskToQuery=*/NULL);
 }
 
+ottf_task_handle_t ottf_task_get_handle(const char *task_name) {
+  return xTaskGetHandle(/*pcNameToQuery=*/task_name);
+}
+
+bool ottf_task_notify(ottf_task_handle_t task) {
+#if configUSE_TASK_NOTIFICATIONS
+  if (task == NULL) {
+    return false;
+  }
+  return xTaskNotifyGive(/*xTaskToNotify=*/task) == pdPASS;
+#else
+  return false;
+#endif  // configUSE_TASK_NOTIFICATIONS
+}
+
+bool ottf_task_notify_from_isr(ottf_task_handle_t task) {
+#if configUSE_TASK_NOTIFICATIONS
+  if (task == NULL) {
+    return false;
+  }
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  vTaskNotifyGiveFromISR(
+      /*xTaskToNotify=*/task,
+      /*pxHigherPriorityTaskWoken=*/&higher_priority_task_woken);
+  // The OTTF ISR exit code restores the context of the task `pxCurrentTCB`
+  // points to, so switching here is sufficient to run the notified task next.
+  if (higher_priority_task_woken != pdFALSE) {
+    vTaskSwitchContext();
+  }
+  return true;
+#else
+  return false;
+#endif  // configUSE_TASK_NOTIFICATIONS
+}
+
+uint32_t ottf_task_notify_wait(uint32_t timeout_ms) {
+#if configUSE_TASK_NOTIFICATIONS
+  return ulTaskNotifyTake(/*xClearCountOnExit=*/pdTRUE,
+                          /*xTicksToWait=*/pdMS_TO_TICKS(timeout_ms));
+#else
+  return 0;
+#endif  // configUSE_TASK_NOTIFICATIONS
+}
+
+#if configGENERATE_RUN_TIME_STATS
+enum {
+  /**
+   * Maximum number of tasks reported by `ottf_task_log_runtime_stats()`,
+   * including the idle task.
+   */
+  kOttfRuntimeStatsMaxTasks = 16,
+};
+
+// FreeRTOS is built with heap_1, which never frees memory, so the stats
+// snapshot is kept in a static buffer rather than allocated on every call.
+static TaskStatus_t task_stats[kOttfRuntimeStatsMaxTasks];
+#endif  // configGENERATE_RUN_TIME_STATS
+
+bool ottf_task_log_runtime_stats(void) {
+#if configGENERATE_RUN_TIME_STATS
+  uint32_t total_run_time = 0;
+  UBaseType_t num_tasks = uxTaskGetSystemState(
+      /*pxTaskStatusArray=*/task_stats,
+      /*uxArraySize=*/ARRAYSIZE(task_stats),
+      /*pulTotalRunTime=*/&total_run_time);
+  if (num_tasks == 0) {
+    LOG_ERROR("Too many tasks for run-time stats (max: %u).",
+              (uint32_t)kOttfRuntimeStatsMaxTasks);
+    return false;
+  }
+  if (total_run_time == 0) {
+    total_run_time = 1;
+  }
+  LOG_INFO("Run-time stats for %u tasks over %u cycles:", (uint32_t)num_tasks,
+           total_run_time);
+  for (size_t i = 0; i < num_tasks; ++i) {
+    uint32_t cycles = task_stats[i].ulRunTimeCounter;
+    uint32_t percent = (uint32_t)((uint64_t)cycles * 100 / total_run_time);
+    LOG_INFO("  %s: %u cycles (%u%%)", task_stats[i].pcTaskName, cycles,
+             percent);
+  }
+  return true;
+#else
+  LOG_WARNING("Run-time stats require the preemptive OTTF configuration.");
+  return false;
+#endif  // configGENERATE_RUN_TIME_STATS
+}
+
 static void report_test_status(bool result) {
   // Reinitialize UART before print any debug output if the test clobbered it.
   if (kDeviceType != kDeviceSimDV) {
@@ -105,6 +105,83 @@ void ottf_task_delete_self(void);
  */
 char *ottf_task_get_self_name(void);
 
+/**
+ * Opaque handle to a FreeRTOS task.
+ *
+ * This should match the `TaskHandle_t` type declaration in
+ * `<freertos kernel>/include/task.h`.
+ */
+typedef void *ottf_task_handle_t;
+
+/**
+ * Returns the handle of the FreeRTOS task named `task_name`, or NULL if there
+ * is no such task.
+ *
+ * This must not be called from an ISR. ISRs that notify tasks should look up
+ * the handle beforehand.
+ *
+ * See the FreeRTOS `xTaskGetHandle` documentation for more details:
+ * https://www.freertos.org/a00021.html#xTaskGetHandle.
+ */
+ottf_task_handle_t ottf_task_get_handle(const char *task_name);
+
+/**
+ * Sends a notification to a FreeRTOS task, unblocking it if it is waiting in
+ * `ottf_task_notify_wait()`.
+ *
+ * Task notifications are only available in the preemptive OTTF configuration
+ * (see `OTTF_PREEMPTIVE` in FreeRTOSConfig.h).
+ *
+ * See the FreeRTOS `xTaskNotifyGive` documentation for more details:
+ * https://www.freertos.org/xTaskNotifyGive.html.
+ *
+ * @param task The task to notify.
+ * @return False if `task` is NULL or notifications are not available.
+ */
+bool ottf_task_notify(ottf_task_handle_t task);
+
+/**
+ * Sends a notification to a FreeRTOS task from an ISR.
+ *
+ * If the notified task has a higher priority than the interrupted task, the
+ * OTTF switches to it on return from the ISR.
+ *
+ * See the FreeRTOS `vTaskNotifyGiveFromISR` documentation for more details:
+ * https://www.freertos.org/vTaskNotifyGiveFromISR.html.
+ *
+ * @param task The task to notify.
+ * @return False if `task` is NULL or notifications are not available.
+ */
+bool ottf_task_notify_from_isr(ottf_task_handle_t task);
+
+/**
+ * Blocks the calling FreeRTOS task until it is notified, or until the timeout
+ * expires, and clears its pending notifications.
+ *
+ * See the FreeRTOS `ulTaskNotifyTake` documentation for more details:
+ * https://www.freertos.org/ulTaskNotifyTake.html.
+ *
+ * @param timeout_ms Maximum time to wait, in milliseconds.
+ * @return Number of notifications received, zero on timeout or if
+ * notifications are not available.
+ */
+uint32_t ottf_task_notify_wait(uint32_t timeout_ms);
+
+/**
+ * Logs the CPU time spent in each FreeRTOS task since the scheduler started,
+ * in cycles and as a percentage of the total.
+ *
+ * Run-time stats are only available in the preemptive OTTF configuration (see
+ * `OTTF_PREEMPTIVE` in FreeRTOSConfig.h). They are accounted with the low word
+ * of `mcycle`, so they wrap after 2^32 cycles.
+ *
+ * See the FreeRTOS `uxTaskGetSystemState` documentation for more details:
+ * https://www.freertos.org/uxTaskGetSystemState.html.
+ *
+ * @return False if run-time stats are not available.
+ */
+bool ottf_task_log_runtime_stats(void);
+
 /**
  * Execute a test function, profile the execution and log the test result.
  * Update the result value if there is a failure code.
@@ -14,6 +14,10 @@
 
 #include "sw/device/lib/testing/usb_testutils_streams.h"
 
+#include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/math.h"
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/runtime/print.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 #include "sw/device/lib/testing/usb_testutils_diags.h"
@@ -32,6 +36,58 @@ static const enum {
  */
 static bool log_traffic = false;
 
+/**
+ * Word-wide LFSR tables, permitting the byte stream produced by LFSR_ADVANCE
+ * to be generated and checked four bytes at a time.
+ *
+ * lfsr_words[n] holds, in little endian byte order, the four bytes emitted by
+ * the LFSR starting from state n, and lfsr_next4[n] is the state that follows
+ * them.
+ */
+static uint32_t lfsr_words[0x100U];
+static uint8_t lfsr_next4[0x100U];
+static bool lfsr_tables_valid = false;
+
+// Populate the word-wide LFSR tables
+static void lfsr_tables_init(void) {
+  if (lfsr_tables_valid) {
+    return;
+  }
+  for (unsigned n = 0U; n < 0x100U; n++) {
+    uint8_t lfsr = (uint8_t)n;
+    uint32_t word = 0U;
+    for (unsigned b = 0U; b < sizeof(uint32_t); b++) {
+      word |= (uint32_t)lfsr << (b * 8U);
+      lfsr = (uint8_t)LFSR_ADVANCE(lfsr);
+    }
+    lfsr_words[n] = word;
+    lfsr_next4[n] = lfsr;
+  }
+  lfsr_tables_valid = true;
+}
+
+// Advance an LFSR by the given number of bytes
+static uint8_t lfsr_advance_bytes(uint8_t lfsr, uint32_t num_bytes) {
+  while (num_bytes >= sizeof(uint32_t)) {
+    lfsr = lfsr_next4[lfsr];
+    num_bytes -= sizeof(uint32_t);
+  }
+  while (num_bytes-- > 0U) {
+    lfsr = (uint8_t)LFSR_ADVANCE(lfsr);
+  }
+  return lfsr;
+}
+
+// Calculate the throughput in bytes/second of a transfer
+static uint32_t throughput_calc(uint32_t num_bytes, uint64_t start_cycles,
+                                uint64_t end_cycles) {
+  if (end_cycles <= start_cycles) {
+    return 0U;
+  }
+  return (uint32_t)udiv64_slow((uint64_t)num_bytes * kClockFreqCpuHz,
+                               end_cycles - start_cycles, NULL);
+}
+
 // Dump a sequence of bytes as hexadecimal and ASCII for diagnostic purposes
 static void buffer_dump(const uint8_t *data, size_t n) {
   base_hexdump_fmt_t fmt = {
@@ -70,41 +126,44 @@ static uint32_t buffer_sig_create(usb_testutils_streams_ctx_t *ctx,
 // Fill a buffer with LFSR-generated data
 static void buffer_fill(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
                         dif_usbdev_buffer_t *buf, uint8_t num_bytes) {
-  alignas(uint32_t) uint8_t data[USBDEV_MAX_PACKET_SIZE];
+  usb_testutils_ctx_t *usbdev = ctx->usbdev;
 
   CHECK(num_bytes <= buf->remaining_bytes);
-  CHECK(num_bytes <= sizeof(data));
+
+  // Note: the buffer is written in place, a word at a time; since it has
+  //       just been requested, it is word-aligned and has room for a full
+  //       packet, so any trailing partial word may be written in its entirety
+  dif_usbdev_buffer_span_t span;
+  CHECK_DIF_OK(dif_usbdev_buffer_span_get(usbdev->dev, buf, &span));
 
   if (s->generating) {
     // Emit LFSR-generated byte stream; keep this brief so that we can
-    // reduce our latency in responding to USB events (usb_testutils employs
-    // polling at present)
+    // reduce our latency in responding to USB events
     uint8_t lfsr = s->tx_lfsr;
 
-    const uint8_t *edp = &data[num_bytes];
-    uint8_t *dp = data;
-    while (dp < edp) {
-      *dp++ = lfsr;
-      lfsr = LFSR_ADVANCE(lfsr);
+    for (uint32_t idx = 0U; idx < num_bytes; idx += sizeof(uint32_t)) {
+      mmio_region_write32(usbdev->dev->base_addr,
+                          span.offset + (ptrdiff_t)idx, lfsr_words[lfsr]);
+      lfsr = lfsr_next4[lfsr];
     }
 
     // Update the LFSR for the next packet
-    s->tx_lfsr = lfsr;
+    s->tx_lfsr = lfsr_advance_bytes(s->tx_lfsr, num_bytes);
   } else {
     // Undefined buffer contents; useful for profiling IN throughput on
     // CW310, because the CPU load at 10MHz can be an appreciable slowdown
   }
 
   if (s->verbose && log_traffic) {
+    alignas(uint32_t) uint8_t data[USBDEV_MAX_PACKET_SIZE];
+    mmio_region_memcpy_from_mmio32(usbdev->dev->base_addr,
+                                   (uint32_t)span.offset, data, num_bytes);
     buffer_dump(data, num_bytes);
   }
 
-  size_t bytes_written;
-
-  CHECK_DIF_OK(dif_usbdev_buffer_write(ctx->usbdev->dev, buf, data, num_bytes,
-                                       &bytes_written));
-  CHECK(bytes_written == num_bytes);
-  s->tx_bytes += bytes_written;
+  CHECK_DIF_OK(dif_usbdev_buffer_span_commit(usbdev->dev, usbdev->buffer_pool,
+                                             buf, num_bytes));
+  s->tx_bytes += num_bytes;
 }
 
 // Check the contents of a received buffer
@@ -115,49 +174,54 @@ static void buffer_check(usb_testutils_streams_ctx_t *ctx, usbdev_stream_t *s,
   uint8_t len = packet_info.length;
 
   if (len > 0) {
-    alignas(uint32_t) uint8_t data[USBDEV_MAX_PACKET_SIZE];
-
-    CHECK(len <= sizeof(data));
+    CHECK(len <= USBDEV_MAX_PACKET_SIZE);
 
-    size_t bytes_read;
-
-    // Notes: the buffer being read here is USBDEV memory accessed as MMIO, so
-    //        only the DIF accesses it directly. when we consume the final bytes
-    //        from the read buffer, it is automatically returned to the buffer
-    //        pool.
-    CHECK_DIF_OK(dif_usbdev_buffer_read(usbdev->dev, usbdev->buffer_pool, &buf,
-                                        data, len, &bytes_read));
-    CHECK(bytes_read == len);
+    // Notes: the buffer being checked here is USBDEV memory accessed as MMIO,
+    //        a word at a time and in place. When we commit the final bytes of
+    //        the read buffer, it is automatically returned to the buffer pool.
+    dif_usbdev_buffer_span_t span;
+    CHECK_DIF_OK(dif_usbdev_buffer_span_get(usbdev->dev, &buf, &span));
 
     if (log_traffic) {
-      buffer_dump(data, bytes_read);
+      alignas(uint32_t) uint8_t data[USBDEV_MAX_PACKET_SIZE];
+      mmio_region_memcpy_from_mmio32(usbdev->dev->base_addr,
+                                     (uint32_t)span.offset, data, len);
+      buffer_dump(data, len);
     }
 
     // Check received data against expected LFSR-generated byte stream;
     // keep this brief so that we can reduce our latency in responding to
-    // USB events (usb_testutils employs polling at present)
+    // USB events
     uint8_t rxtx_lfsr = s->rxtx_lfsr;
     uint8_t rx_lfsr = s->rx_lfsr;
 
-    const uint8_t *esp = &data[bytes_read];
-    const uint8_t *sp = data;
-    while (sp < esp) {
+    for (uint32_t idx = 0U; idx < len; idx += sizeof(uint32_t)) {
       // Received data should be the XOR of two LFSR-generated PRND streams -
-      // ours on the
-      //   transmission side, and that of the DPI model
-      uint8_t expected = rxtx_lfsr ^ rx_lfsr;
-      CHECK(expected == *sp,
-            "S%u: Unexpected received data 0x%02x : (LFSRs 0x%02x 0x%02x)",
-            s->id, *sp, rxtx_lfsr, rx_lfsr);
-
-      rxtx_lfsr = LFSR_ADVANCE(rxtx_lfsr);
-      rx_lfsr = LFSR_ADVANCE(rx_lfsr);
-      sp++;
+      // ours on the transmission side, and that of the DPI model
+      uint32_t expected = lfsr_words[rxtx_lfsr] ^ lfsr_words[rx_lfsr];
+      uint32_t actual = mmio_region_read32(usbdev->dev->base_addr,
+                                           span.offset + (ptrdiff_t)idx);
+      if (len - idx < sizeof(uint32_t)) {
+        // Ignore the undefined bytes beyond the end of the packet
+        uint32_t mask = (1U << ((len - idx) * 8U)) - 1U;
+        expected &= mask;
+        actual &= mask;
+      }
+      CHECK(expected == actual,
+            "S%u: Unexpected received data 0x%08x at offset %u : (LFSRs 0x%02x "
+            "0x%02x)",
+            s->id, actual, idx, rxtx_lfsr, rx_lfsr);
+
+      rxtx_lfsr = lfsr_next4[rxtx_lfsr];
+      rx_lfsr = lfsr_next4[rx_lfsr];
     }
 
     // Update the LFSRs for the next packet
-    s->rxtx_lfsr = rxtx_lfsr;
-    s->rx_lfsr = rx_lfsr;
+    s->rxtx_lfsr = lfsr_advance_bytes(s->rxtx_lfsr, len);
+    s->rx_lfsr = lfsr_advance_bytes(s->rx_lfsr, len);
+
+    CHECK_DIF_OK(dif_usbdev_buffer_span_commit(usbdev->dev, usbdev->buffer_pool,
+                                               &buf, len));
   } else {
     // In the event that we've received a zero-length data packet, we still
     // must return the buffer to the pool
@@ -184,9 +248,10 @@ static void strm_tx_done(void *stream_v, usb_testutils_xfr_result_t result) {
 
   CHECK(nqueued > 0);
 
-  // Note: since buffer transmission and completion signalling both occur within
-  // the foreground code (polling, not interrupt-driven) there is no issue of
-  // potential races here
+  // Note: buffer transmission and completion signalling both occur either
+  // within the foreground code (polling) or within the interrupt handler
+  // (interrupt-driven), never both, so there is no issue of potential races
+  // here
 
   if (nqueued > 0) {
     // Shuffle the buffer descriptions, without using memmove
@@ -201,6 +266,9 @@ static void strm_tx_done(void *stream_v, usb_testutils_xfr_result_t result) {
     if (nqueued) {
       CHECK_DIF_OK(
           dif_usbdev_send(usbdev->dev, tx_ep, &ctx->tx_bufs[tx_ep][0u]));
+    } else if (s->tx_bytes >= s->transfer_bytes && !s->tx_done_cycles) {
+      // Final packet has been collected by the host
+      s->tx_done_cycles = ibex_mcycle_read();
     }
   }
 }
@@ -254,6 +322,9 @@ static void strm_rx(void *stream_v, dif_usbdev_rx_packet_info_t packet_info,
   }
 
   s->rx_bytes += packet_info.length;
+  if (s->rx_bytes >= s->transfer_bytes && !s->rx_done_cycles) {
+    s->rx_done_cycles = ibex_mcycle_read();
+  }
 }
 
 // Callback for unexpected data reception (IN endpoint)
@@ -312,6 +383,8 @@ status_t usb_testutils_stream_init(usb_testutils_streams_ctx_t *ctx, uint8_t id,
   s->tx_bytes = 0u;
   s->rx_bytes = 0u;
   s->transfer_bytes = transfer_bytes;
+  s->tx_done_cycles = 0u;
+  s->rx_done_cycles = 0u;
 
   // Initialize the LFSR state for transmission and reception sides
   // - we use a simple LFSR to generate a PRND stream to transmit to the USBPI
@@ -321,6 +394,7 @@ status_t usb_testutils_stream_init(usb_testutils_streams_ctx_t *ctx, uint8_t id,
   s->tx_lfsr = USBTST_LFSR_SEED(id);
   s->rxtx_lfsr = s->tx_lfsr;
   s->rx_lfsr = USBDPI_LFSR_SEED(id);
+  lfsr_tables_init();
 
   // Packet size randomization
   s->tx_buf_size = BUFSZ_LFSR_SEED(id);
@@ -345,13 +419,11 @@ status_t usb_testutils_stream_init(usb_testutils_streams_ctx_t *ctx, uint8_t id,
   return OK_STATUS();
 }
 
-// Service the given stream, preparing and/or sending any data that we can;
-// data reception is handled via callbacks and requires no attention here
-status_t usb_testutils_stream_service(usb_testutils_streams_ctx_t *ctx,
-                                      uint8_t id) {
-  // Locate the stream context information
-  TRY_CHECK(id < USBUTILS_STREAMS_MAX);
-  usbdev_stream_t *s = &ctx->streams[id];
+// Prepare and queue another buffer for transmission on the given stream, if
+// we can; `queued` indicates whether a buffer was queued
+static status_t stream_buffer_queue(usb_testutils_streams_ctx_t *ctx,
+                                    usbdev_stream_t *s, bool *queued) {
+  *queued = false;
 
   // Generate output data as soon as possible and make it available for
   //   collection by the host
@@ -402,8 +474,8 @@ status_t usb_testutils_stream_service(usb_testutils_streams_ctx_t *ctx,
       // Remember the buffer until we're informed that it has been
       // successfully transmitted
       //
-      // Note: since the 'tx_done' callback occurs from foreground code that
-      // is polling, there is no issue of interrupt races here
+      // Note: since the 'tx_done' callback occurs within the same context as
+      // this code, there is no issue of interrupt races here
       ctx->tx_bufs[tx_ep][nqueued] = buf;
       ctx->tx_bufs_queued[tx_ep] = ++nqueued;
       ctx->tx_queued_total++;
@@ -419,6 +491,7 @@ status_t usb_testutils_stream_service(usb_testutils_streams_ctx_t *ctx,
             s->id, bufs_sent, num_bytes);
       }
       bufs_sent++;
+      *queued = true;
     } else {
       // If we have no more buffers available right now, continue polling...
       CHECK(dif_result == kDifUnavailable);
@@ -427,6 +500,17 @@ status_t usb_testutils_stream_service(usb_testutils_streams_ctx_t *ctx,
   return OK_STATUS();
 }
 
+// Service the given stream, preparing and/or sending any data that we can;
+// data reception is handled via callbacks and requires no attention here
+status_t usb_testutils_stream_service(usb_testutils_streams_ctx_t *ctx,
+                                      uint8_t id) {
+  // Locate the stream context information
+  TRY_CHECK(id < USBUTILS_STREAMS_MAX);
+
+  bool queued;
+  return stream_buffer_queue(ctx, &ctx->streams[id], &queued);
+}
+
 status_t usb_testutils_streams_init(usb_testutils_streams_ctx_t *ctx,
                                     unsigned nstreams, uint32_t num_bytes,
                                     usbdev_stream_flags_t flags, bool verbose) {
@@ -434,6 +518,7 @@ status_t usb_testutils_streams_init(usb_testutils_streams_ctx_t *ctx,
 
   // Remember the stream count
   ctx->nstreams = nstreams;
+  ctx->start_cycles = ibex_mcycle_read();
 
   // Initialize the state of each stream
   for (unsigned id = 0U; id < nstreams; id++) {
@@ -472,6 +557,53 @@ status_t usb_testutils_streams_service(usb_testutils_streams_ctx_t *ctx) {
   return OK_STATUS();
 }
 
+// Queue as many buffers as we can on every stream
+static status_t streams_fill(usb_testutils_streams_ctx_t *ctx) {
+  for (unsigned id = 0U; id < ctx->nstreams; id++) {
+    bool queued;
+    do {
+      TRY(stream_buffer_queue(ctx, &ctx->streams[id], &queued));
+    } while (queued);
+  }
+  return OK_STATUS();
+}
+
+status_t usb_testutils_streams_irq_enable(usb_testutils_streams_ctx_t *ctx) {
+  dif_usbdev_t *dev = ctx->usbdev->dev;
+
+  // Present the initial buffers for transmission; subsequent buffers are
+  // presented in response to pkt_sent interrupts
+  TRY(streams_fill(ctx));
+
+  TRY(dif_usbdev_irq_acknowledge_all(dev));
+  TRY(dif_usbdev_irq_set_enabled(dev, kDifUsbdevIrqPktReceived,
+                                 kDifToggleEnabled));
+  TRY(dif_usbdev_irq_set_enabled(dev, kDifUsbdevIrqPktSent, kDifToggleEnabled));
+  TRY(dif_usbdev_irq_set_enabled(dev, kDifUsbdevIrqLinkReset,
+                                 kDifToggleEnabled));
+  return OK_STATUS();
+}
+
+status_t usb_testutils_streams_irq_service(usb_testutils_streams_ctx_t *ctx) {
+  // Handle packet reception and transmission completion; buffers that have
+  // been freed may now be used for further transmission
+  usb_testutils_poll(ctx->usbdev);
+  return streams_fill(ctx);
+}
+
+status_t usb_testutils_streams_report(const usb_testutils_streams_ctx_t *ctx) {
+  for (unsigned id = 0U; id < ctx->nstreams; id++) {
+    const usbdev_stream_t *s = &ctx->streams[id];
+    LOG_INFO("S%u: IN ep %u 0x%x byte(s) %u B/s, OUT ep %u 0x%x byte(s) %u B/s",
+             s->id, s->tx_ep, s->tx_bytes,
+             throughput_calc(s->tx_bytes, ctx->start_cycles, s->tx_done_cycles),
+             s->rx_ep, s->rx_bytes,
+             throughput_calc(s->rx_bytes, ctx->start_cycles,
+                             s->rx_done_cycles));
+  }
+  return OK_STATUS();
+}
+
 bool usb_testutils_streams_completed(const usb_testutils_streams_ctx_t *ctx) {
   // See whether any streams still have more work to do
   unsigned id = 0U;
@@ -154,6 +154,16 @@ typedef struct usbdev_stream {
    * Total number of bytes received from the USB device
    */
   uint32_t rx_bytes;
+  /**
+   * Cycle count at which the final IN packet was collected by the host,
+   * or zero if the transmission side has not yet completed
+   */
+  uint64_t tx_done_cycles;
+  /**
+   * Cycle count at which the final OUT packet was received, or zero if the
+   * reception side has not yet completed
+   */
+  uint64_t rx_done_cycles;
   /**
    * Size of transfer in bytes
    */
@@ -190,6 +200,11 @@ struct usb_testutils_streams_ctx {
    * Number of streams in use
    */
   unsigned nstreams;
+  /**
+   * Cycle count at which the streams were initialized; used for throughput
+   * reporting
+   */
+  uint64_t start_cycles;
   /**
    * State information for each of the test streams
    */
@@ -241,6 +256,46 @@ status_t usb_testutils_streams_init(usb_testutils_streams_ctx_t *ctx,
  */
 status_t usb_testutils_streams_service(usb_testutils_streams_ctx_t *ctx);
 
+/**
+ * Enable interrupt-driven servicing of all streams.
+ *
+ * This presents the initial buffers for transmission on every stream and then
+ * enables the pkt_received, pkt_sent and link_reset interrupts of the USB
+ * device. The caller is responsible for routing the USB device interrupts
+ * through the PLIC and for invoking usb_testutils_streams_irq_service() from
+ * its external interrupt handler.
+ *
+ * Note: once interrupt-driven servicing has been enabled, the foreground code
+ *       must not call usb_testutils_poll() or any of the stream service
+ *       functions, because these are not re-entrant.
+ *
+ * @param  ctx       Context state for streaming test
+ * @return The result status of the operation.
+ */
+status_t usb_testutils_streams_irq_enable(usb_testutils_streams_ctx_t *ctx);
+
+/**
+ * Service all streams in response to a USB device interrupt.
+ *
+ * This handles packet reception and transmission completion via
+ * usb_testutils_poll(), and then queues as many buffers for transmission on
+ * each stream as its limits allow, so that the endpoints remain busy until the
+ * next interrupt.
+ *
+ * @param  ctx       Context state for streaming test
+ * @return The result status of the operation.
+ */
+status_t usb_testutils_streams_irq_service(usb_testutils_streams_ctx_t *ctx);
+
+/**
+ * Report the number of bytes transferred and the throughput achieved by each
+ * stream, in each direction, since the streams were initialized.
+ *
+ * @param  ctx       Context state for streaming test
+ * @return The result status of the operation.
+ */
+status_t usb_testutils_streams_report(const usb_testutils_streams_ctx_t *ctx);
+
 /**
  * Returns an indication of whether all streams have completed their data
  * transfers.
@@ -11,6 +11,7 @@
 #include "sw/device/sca/lib/prng.h"
 #include "sw/device/sca/lib/sca.h"
 #include "sw/device/sca/lib/simple_serial.h"
+#include "sw/device/silicon_creator/lib/crc32.h"
 
 #if !OT_IS_ENGLISH_BREAKFAST
 #include "sw/device/lib/testing/aes_testutils.h"
@@ -30,6 +31,7 @@
  *   - FvsR batch fixed key set ('t')*,
  *   - FvsR batch generate ('g')*,
  *   - FvsR batch encrypt and generate ('f')*,
+ *   - Batch digest enable ('d')*,
  * Commands marked with * are implemented in this file. Those marked with + are
  * implemented in the simple serial library. Encryption is done in AES-ECB-128
  * mode. See https://wiki.newae.com/SimpleSerial for details on the protocol.
@@ -91,6 +93,21 @@ uint8_t key_fixed[kAesKeyLength];
  */
 static uint32_t block_ctr;
 
+/**
+ * Whether batch commands fold every ciphertext into `batch_digest`.
+ */
+static bool batch_digest_enabled;
+
+/**
+ * CRC32 context over all ciphertexts of the current batch.
+ */
+static uint32_t batch_digest;
+
+/**
+ * Last ciphertext of the current batch, when `batch_digest_enabled` is set.
+ */
+static dif_aes_data_t batch_last_ciphertext;
+
 static dif_aes_t aes;
 
 dif_aes_transaction_t transaction = {
@@ -197,19 +214,28 @@ static void aes_encrypt(const uint8_t *plaintext, size_t plaintext_len) {
 }
 
 /**
- * Wait until AES output is valid and then get ciphertext and send it over
- * serial communication.
+ * Wait until AES output is valid and then read the ciphertext.
  *
- * @param only_first_word Send only the first word of the ciphertext.
+ * @param[out] ciphertext Ciphertext.
  */
-static void aes_send_ciphertext(bool only_first_word) {
+static void aes_read_ciphertext(dif_aes_data_t *ciphertext) {
   bool ready = false;
   do {
     SS_CHECK_DIF_OK(dif_aes_get_status(&aes, kDifAesStatusOutputValid, &ready));
   } while (!ready);
 
+  SS_CHECK_DIF_OK(dif_aes_read_output(&aes, ciphertext));
+}
+
+/**
+ * Wait until AES output is valid and then get ciphertext and send it over
+ * serial communication.
+ *
+ * @param only_first_word Send only the first word of the ciphertext.
+ */
+static void aes_send_ciphertext(bool only_first_word) {
   dif_aes_data_t ciphertext;
-  SS_CHECK_DIF_OK(dif_aes_read_output(&aes, &ciphertext));
+  aes_read_ciphertext(&ciphertext);
 
   if (only_first_word) {
     simple_serial_send_packet('r', (uint8_t *)ciphertext.data, 4);
@@ -218,6 +244,49 @@ static void aes_send_ciphertext(bool only_first_word) {
   }
 }
 
+/**
+ * Starts a new batch digest.
+ */
+static void aes_batch_digest_start(void) {
+  if (batch_digest_enabled) {
+    crc32_init(&batch_digest);
+  }
+}
+
+/**
+ * Folds the ciphertext of the last encryption into the batch digest.
+ *
+ * This must be called after `aes_encrypt()` returns, i.e. after the AES unit
+ * has finished and outside of the capture window, and before the next
+ * plaintext is loaded. It does nothing if batch digests are disabled.
+ */
+static void aes_batch_digest_add(void) {
+  if (!batch_digest_enabled) {
+    return;
+  }
+  aes_read_ciphertext(&batch_last_ciphertext);
+  crc32_add(&batch_digest, batch_last_ciphertext.data, kAesTextLength);
+}
+
+/**
+ * Sends the result of a batch.
+ *
+ * Sends the first word of the last ciphertext in an 'r' packet. If batch
+ * digests are enabled, this is followed by a 'd' packet holding the CRC32 of
+ * all ciphertexts of the batch in encryption order, as a little-endian
+ * `uint32_t`.
+ */
+static void aes_send_batch_result(void) {
+  if (!batch_digest_enabled) {
+    aes_send_ciphertext(true);
+    return;
+  }
+  simple_serial_send_packet('r', (uint8_t *)batch_last_ciphertext.data, 4);
+  uint8_t digest[sizeof(uint32_t)];
+  write_32(crc32_finish(&batch_digest), digest);
+  simple_serial_send_packet('d', digest, sizeof(digest));
+}
+
 /**
  * Simple serial 'p' (encrypt) command handler.
  *
@@ -268,7 +337,8 @@ static void aes_serial_single_encrypt(const uint8_t *plaintext,
  * using 'k' (key set) command before starting batch captures.
  *
  * Note that the host can partially verify this operation by checking the
- * contents of the 'r' (ciphertext) packet that is sent at the end.
+ * contents of the 'r' (ciphertext) packet that is sent at the end. For full
+ * verification, enable batch digests with the 'd' command.
  *
  * @param data Packet payload.
  * @param data_len Packet payload length.
@@ -287,15 +357,17 @@ static void aes_serial_batch_encrypt(const uint8_t *data, size_t data_len) {
     block_ctr = num_encryptions;
   }
 
+  aes_batch_digest_start();
   sca_set_trigger_high();
   for (uint32_t i = 0; i < num_encryptions; ++i) {
     uint8_t plaintext[kAesTextLength];
     prng_rand_bytes(plaintext, kAesTextLength);
     aes_encrypt(plaintext, kAesTextLength);
+    aes_batch_digest_add();
   }
   sca_set_trigger_low();
 
-  aes_send_ciphertext(true);
+  aes_send_batch_result();
 }
 
 /**
@@ -389,7 +461,7 @@ static void aes_serial_fvsr_key_batch_generate(const uint8_t *data,
  *
  * Note that the host can partially verify this operation by checking the
  * contents of the 'r' (last ciphertext) packet that is sent at the end of every
- * batch.
+ * batch. For full verification, enable batch digests with the 'd' command.
  *
  * @param data Packet payload.
  * @param data_len Packet payload length.
@@ -401,21 +473,44 @@ static void aes_serial_fvsr_key_batch_encrypt(const uint8_t *data,
   num_encryptions = read_32(data);
   SS_CHECK(num_encryptions <= kNumBatchOpsMax);
 
+  aes_batch_digest_start();
   sca_set_trigger_high();
   for (uint32_t i = 0; i < num_encryptions; ++i) {
     aes_key_mask_and_config(batch_keys[i], kAesKeyLength);
     aes_encrypt(batch_plaintexts[i], kAesTextLength);
+    aes_batch_digest_add();
   }
   sca_set_trigger_low();
 
   // Only send the first word to increase capture rate
-  aes_send_ciphertext(true);
+  aes_send_batch_result();
 
   // Start to generate random keys and plaintexts for the next batch when the
   // waves are getting from scope by the host to increase capture rate.
   aes_serial_fvsr_key_batch_generate(data, data_len);
 }
 
+/**
+ * Simple serial 'd' (batch digest enable) command handler.
+ *
+ * When enabled, the 'b' and 'f' batch commands read the ciphertext of every
+ * encryption once the AES unit is done with it, fold it into a CRC32 and send
+ * the result in a 'd' packet after the usual 'r' packet. This lets the host
+ * check every encryption of a batch at the cost of one ciphertext read per
+ * encryption, which happens while the trigger is low for that encryption.
+ *
+ * The payload must be a single byte: 1 to enable batch digests, 0 to disable
+ * them. Batch digests are disabled by default.
+ *
+ * @param data Packet payload.
+ * @param data_len Packet payload length.
+ */
+static void aes_serial_batch_digest_enable(const uint8_t *data,
+                                           size_t data_len) {
+  SS_CHECK(data_len == 1 && data[0] <= 1);
+  batch_digest_enabled = data[0] == 1;
+}
+
 /**
  * Initializes the AES peripheral.
  */
@@ -444,6 +539,7 @@ bool test_main(void) {
   simple_serial_register_handler('t', aes_serial_fvsr_key_set);
   simple_serial_register_handler('g', aes_serial_fvsr_key_batch_generate);
   simple_serial_register_handler('f', aes_serial_fvsr_key_batch_encrypt);
+  simple_serial_register_handler('d', aes_serial_batch_digest_enable);
 
   LOG_INFO("Initializing AES unit.");
   init_aes();
@@ -30,9 +30,14 @@
 // NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "sw/device/sca/lib/prng.h"
+
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#include "sw/device/lib/base/memory.h"
+
 /**
  * Mersenne Twister PRNG modified from:
  * http://www.math.sci.hiroshima-u.ac.jp/m-mat/MT/MT2002/CODES/mt19937ar.c
@@ -151,14 +156,72 @@ __attribute__((noinline)) static uint32_t genrand_int32(void) {
  */
 
 /**
- * TODO(alphan): Using MT for now as a proof of concept to minimize host-side
- * changes. We should probably replace this with a PRNG from xoshiro* family
- * for PRNGs, e.g. xoshiro128++, for better performance and less overhead.
+ * xoshiro128++ PRNG by David Blackman and Sebastiano Vigna, see
+ * https://prng.di.unimi.it/xoshiro128plusplus.c.
+ */
+static uint32_t xoshiro_state[4];
+
+static inline uint32_t xoshiro_rotl(uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+static uint32_t xoshiro128pp_next(void) {
+  const uint32_t result =
+      xoshiro_rotl(xoshiro_state[0] + xoshiro_state[3], 7) + xoshiro_state[0];
+  const uint32_t t = xoshiro_state[1] << 9;
+
+  xoshiro_state[2] ^= xoshiro_state[0];
+  xoshiro_state[3] ^= xoshiro_state[1];
+  xoshiro_state[1] ^= xoshiro_state[2];
+  xoshiro_state[0] ^= xoshiro_state[3];
+  xoshiro_state[2] ^= t;
+  xoshiro_state[3] = xoshiro_rotl(xoshiro_state[3], 11);
+
+  return result;
+}
+
+/**
+ * Seeds xoshiro128++ by expanding `seed` with SplitMix64, as recommended by
+ * the authors. The two 64-bit outputs fill the state little-endian first.
  */
+static void xoshiro128pp_seed(uint32_t seed) {
+  uint64_t x = seed;
+  for (size_t i = 0; i < 2; ++i) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    xoshiro_state[2 * i] = (uint32_t)z;
+    xoshiro_state[2 * i + 1] = (uint32_t)(z >> 32);
+  }
+}
+
+static prng_algorithm_t algorithm = kPrngAlgorithmMt19937;
+
+void prng_seed(uint32_t seed) {
+  algorithm = kPrngAlgorithmMt19937;
+  init_by_array(&seed, 1);
+}
 
-void prng_seed(uint32_t seed) { init_by_array(&seed, 1); }
+bool prng_seed_algorithm(prng_algorithm_t algo, uint32_t seed) {
+  switch (algo) {
+    case kPrngAlgorithmMt19937:
+      prng_seed(seed);
+      return true;
+    case kPrngAlgorithmXoshiro128pp:
+      algorithm = kPrngAlgorithmXoshiro128pp;
+      xoshiro128pp_seed(seed);
+      return true;
+    default:
+      return false;
+  }
+}
 
 uint8_t prng_rand_byte(void) {
+  if (algorithm == kPrngAlgorithmXoshiro128pp) {
+    return (uint8_t)xoshiro128pp_next();
+  }
+
   uint32_t rand = 0;
   do {
     /**
@@ -175,6 +238,20 @@ uint8_t prng_rand_byte(void) {
 }
 
 void prng_rand_bytes(uint8_t *buffer, size_t buffer_len) {
+  if (algorithm == kPrngAlgorithmXoshiro128pp) {
+    for (; buffer_len >= sizeof(uint32_t); buffer_len -= sizeof(uint32_t)) {
+      write_32(xoshiro128pp_next(), buffer);
+      buffer += sizeof(uint32_t);
+    }
+    if (buffer_len > 0) {
+      uint32_t rand = xoshiro128pp_next();
+      for (; buffer_len > 0; --buffer_len, rand >>= 8) {
+        *buffer++ = (uint8_t)rand;
+      }
+    }
+    return;
+  }
+
   for (size_t i = 0; i < buffer_len; ++i) {
     buffer[i] = prng_rand_byte();
   }
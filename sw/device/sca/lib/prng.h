@@ -5,6 +5,7 @@
 #ifndef OPENTITAN_SW_DEVICE_SCA_LIB_PRNG_H_
 #define OPENTITAN_SW_DEVICE_SCA_LIB_PRNG_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -16,28 +17,57 @@ extern "C" {
  * @file
  * @brief PRNG for side-channel analysis.
  *
- * This library provides a Mersenne Twister PRNG that can be used to generate
- * random plaintexts on the device. Generating random plaintexts on the device
- * eliminates the overhead of sending them from the host and can significantly
- * improve capture rate. The host must use the same PRNG to be able to compute
- * the plaintext and the ciphertext of each trace.
+ * This library provides PRNGs that can be used to generate random plaintexts
+ * on the device. Generating random plaintexts on the device eliminates the
+ * overhead of sending them from the host and can significantly improve capture
+ * rate. The host must use the same PRNG to be able to compute the plaintext and
+ * the ciphertext of each trace; `prng.py` in this directory is a reference
+ * implementation for the host side.
  *
- * TODO(alphan): Replace this with a more efficient PRNG after updating
- * host-side code.
+ * The default Mersenne Twister matches python's `random` module, which is what
+ * ChipWhisperer's `ktp.next()` uses, but produces only about one byte per two
+ * outputs. xoshiro128++ is much cheaper and produces four bytes per output.
  */
 
+/**
+ * PRNG algorithms.
+ */
+typedef enum prng_algorithm {
+  /**
+   * Mersenne Twister, matching `random.randint(0, 255)` in python.
+   */
+  kPrngAlgorithmMt19937 = 0,
+  /**
+   * xoshiro128++, seeded with SplitMix64.
+   */
+  kPrngAlgorithmXoshiro128pp = 1,
+} prng_algorithm_t;
+
 /**
  * Initializes the random number generator.
  *
+ * Selects the Mersenne Twister algorithm.
+ *
  * @param seed Seed to initalize with.
  */
 void prng_seed(uint32_t seed);
 
+/**
+ * Selects and initializes a random number generator algorithm.
+ *
+ * @param algo Algorithm to use.
+ * @param seed Seed to initalize with.
+ * @return Whether `algo` is a valid algorithm.
+ */
+bool prng_seed_algorithm(prng_algorithm_t algo, uint32_t seed);
+
 /**
  * Generates a random byte.
  *
- * The behavior of this function matches the behavior of `random.randint(0,
- * 255)` in python, which is used by ChipWhisperer's `ktp.next()`.
+ * With Mersenne Twister, the behavior of this function matches the behavior of
+ * `random.randint(0, 255)` in python, which is used by ChipWhisperer's
+ * `ktp.next()`. With xoshiro128++, this is the least significant byte of the
+ * next output.
  *
  * @return A random byte.
  */
@@ -46,8 +76,10 @@ uint8_t prng_rand_byte(void);
 /**
  * Fills a buffer with random bytes.
  *
- * The behavior of this function matches the behavior of `random.randint(0,
- * 255)` in python, which is used by ChipWhisperer's `ktp.next()`.
+ * With Mersenne Twister, the behavior of this function matches the behavior of
+ * `random.randint(0, 255)` in python, which is used by ChipWhisperer's
+ * `ktp.next()`. With xoshiro128++, each output fills four bytes in
+ * little-endian order, and the unused bytes of the last output are discarded.
  *
  * @param[out] buffer     A buffer.
  * @param      buffer_len Size of the buffer.
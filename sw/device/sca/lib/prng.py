@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+# Copyright lowRISC contributors.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+"""Host-side reference for the xoshiro128++ PRNG in prng.c.
+
+SCA capture scripts use this to recompute the plaintexts, keys and messages
+that the device generates after `simple_serial` receives an 's' command whose
+payload selects `kPrngAlgorithmXoshiro128pp`. The Mersenne Twister default
+matches python's own `random` module and needs no reference.
+"""
+
+import argparse
+
+MASK32 = 0xffffffff
+MASK64 = 0xffffffffffffffff
+
+
+def _rotl(x: int, k: int) -> int:
+    return ((x << k) | (x >> (32 - k))) & MASK32
+
+
+class Xoshiro128pp:
+    """xoshiro128++ seeded from a 32-bit value with SplitMix64."""
+
+    def __init__(self, seed: int):
+        x = seed & MASK32
+        self.s = []
+        for _ in range(2):
+            x = (x + 0x9e3779b97f4a7c15) & MASK64
+            z = x
+            z = ((z ^ (z >> 30)) * 0xbf58476d1ce4e5b9) & MASK64
+            z = ((z ^ (z >> 27)) * 0x94d049bb133111eb) & MASK64
+            z ^= z >> 31
+            self.s += [z & MASK32, z >> 32]
+
+    def next(self) -> int:
+        """Returns the next 32-bit output."""
+        s = self.s
+        result = (_rotl((s[0] + s[3]) & MASK32, 7) + s[0]) & MASK32
+        t = (s[1] << 9) & MASK32
+        s[2] ^= s[0]
+        s[3] ^= s[1]
+        s[1] ^= s[2]
+        s[0] ^= s[3]
+        s[2] ^= t
+        s[3] = _rotl(s[3], 11)
+        return result
+
+    def rand_byte(self) -> int:
+        """Matches `prng_rand_byte()`."""
+        return self.next() & 0xff
+
+    def rand_bytes(self, n: int) -> bytes:
+        """Matches one call to `prng_rand_bytes()` for `n` bytes."""
+        words = (n + 3) // 4
+        out = b"".join(self.next().to_bytes(4, "little") for _ in range(words))
+        return out[:n]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("seed", type=lambda x: int(x, 0))
+    parser.add_argument("count", type=int, nargs="?", default=16)
+    args = parser.parse_args()
+    print(Xoshiro128pp(args.seed).rand_bytes(args.count).hex())
+
+
+if __name__ == "__main__":
+    main()
@@ -41,5 +41,54 @@ TEST(RandBytes, Seed_0) {
   EXPECT_THAT(actual, testing::ElementsAreArray(kExpected));
 }
 
+/**
+ * First 8 outputs of `Xoshiro128pp(0).next()` from `prng.py`.
+ */
+constexpr std::array<uint32_t, 8> kExpectedXoshiro = {
+    0x4653daa3, 0x73922b58, 0xb82b4add, 0xd9fabd3b,
+    0x3c8698c3, 0x1c9b58ff, 0xccac4646, 0x27e3fd16,
+};
+
+TEST(RandByte, Xoshiro128ppSeed_0) {
+  std::vector<uint8_t> actual(kExpectedXoshiro.size());
+  std::vector<uint8_t> expected;
+  for (uint32_t word : kExpectedXoshiro) {
+    expected.push_back(static_cast<uint8_t>(word));
+  }
+
+  EXPECT_TRUE(prng_seed_algorithm(kPrngAlgorithmXoshiro128pp, 0));
+  std::generate(actual.begin(), actual.end(), prng_rand_byte);
+  EXPECT_THAT(actual, testing::ElementsAreArray(expected));
+}
+
+TEST(RandBytes, Xoshiro128ppSeed_0) {
+  // A 10-byte request consumes three outputs and discards the last two bytes
+  // of the third; the next request starts at the fourth output.
+  std::array<uint8_t, 10> first;
+  std::array<uint8_t, 4> second;
+
+  EXPECT_TRUE(prng_seed_algorithm(kPrngAlgorithmXoshiro128pp, 0));
+  prng_rand_bytes(first.data(), first.size());
+  prng_rand_bytes(second.data(), second.size());
+  EXPECT_THAT(first, testing::ElementsAreArray({
+                         0xa3, 0xda, 0x53, 0x46, 0x58,
+                         0x2b, 0x92, 0x73, 0xdd, 0x4a,
+                     }));
+  EXPECT_THAT(second, testing::ElementsAreArray({0x3b, 0xbd, 0xfa, 0xd9}));
+}
+
+TEST(SeedAlgorithm, SwitchBackToMt) {
+  std::vector<uint8_t> actual(kExpected.size());
+
+  EXPECT_TRUE(prng_seed_algorithm(kPrngAlgorithmXoshiro128pp, 0));
+  EXPECT_TRUE(prng_seed_algorithm(kPrngAlgorithmMt19937, 0));
+  std::generate(actual.begin(), actual.end(), prng_rand_byte);
+  EXPECT_THAT(actual, testing::ElementsAreArray(kExpected));
+}
+
+TEST(SeedAlgorithm, BadAlgorithm) {
+  EXPECT_FALSE(prng_seed_algorithm(static_cast<prng_algorithm_t>(2), 0));
+}
+
 }  // namespace
 }  // namespace sca_prng_unittest
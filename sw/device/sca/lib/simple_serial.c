@@ -10,6 +10,7 @@
 #include "sw/device/lib/dif/dif_uart.h"
 #include "sw/device/lib/runtime/print.h"
 #include "sw/device/sca/lib/prng.h"
+#include "sw/device/silicon_creator/lib/crc32.h"
 
 #include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
 
@@ -27,9 +28,31 @@ enum {
    * Simple serial protocol version 1.1.
    */
   kSimpleSerialProtocolVersion = 1,
+  /**
+   * Binary framed variant of the protocol, see `simple_serial_version()`.
+   */
+  kSimpleSerialProtocolVersionBinary = 2,
   kUartMaxRxPacketSize = 64,
+  /**
+   * Maximum payload length of a binary frame.
+   */
+  kBinaryFrameMaxPayload = UINT8_MAX,
 };
 
+/**
+ * Framing used for packets on the wire.
+ */
+typedef enum simple_serial_framing {
+  /**
+   * Command character, hex encoded payload and '\n' terminator.
+   */
+  kSimpleSerialFramingText,
+  /**
+   * Command byte, length byte, raw payload and CRC32.
+   */
+  kSimpleSerialFramingBinary,
+} simple_serial_framing_t;
+
 /**
  * Command handlers.
  *
@@ -42,6 +65,7 @@ enum {
  */
 static simple_serial_command_handler handlers[27];
 static const dif_uart_t *uart;
+static simple_serial_framing_t framing;
 
 static bool simple_serial_is_valid_command(uint8_t cmd) {
   return cmd >= 'a' && cmd <= 'z';
@@ -117,6 +141,123 @@ static void simple_serial_receive_packet(uint8_t *cmd, uint8_t *data,
   }
 }
 
+/**
+ * Receives exactly `len` bytes over UART, draining the RX FIFO in bulk.
+ *
+ * @param[out] data Buffer for the received bytes.
+ * @param len Number of bytes to receive.
+ */
+static void simple_serial_receive_bytes(uint8_t *data, size_t len) {
+  while (len > 0) {
+    size_t bytes_read = 0;
+    IGNORE_RESULT(dif_uart_bytes_receive(uart, len, data, &bytes_read));
+    data += bytes_read;
+    len -= bytes_read;
+  }
+}
+
+/**
+ * Receives and drops exactly `len` bytes over UART.
+ *
+ * @param len Number of bytes to drop.
+ */
+static void simple_serial_skip_bytes(size_t len) {
+  uint8_t scratch[16];
+  while (len > 0) {
+    size_t chunk = len < sizeof(scratch) ? len : sizeof(scratch);
+    simple_serial_receive_bytes(scratch, chunk);
+    len -= chunk;
+  }
+}
+
+/**
+ * Sends exactly `len` bytes over UART, filling the TX FIFO in bulk.
+ *
+ * @param data Bytes to send.
+ * @param len Number of bytes to send.
+ */
+static void simple_serial_send_bytes(const uint8_t *data, size_t len) {
+  while (len > 0) {
+    size_t bytes_written = 0;
+    IGNORE_RESULT(dif_uart_bytes_send(uart, data, len, &bytes_written));
+    data += bytes_written;
+    len -= bytes_written;
+  }
+}
+
+/**
+ * Receives a binary framed simple serial packet over UART.
+ *
+ * Binary frames are composed of:
+ * - Command: A single byte character,
+ * - Length: A single byte, the length of the payload,
+ * - Payload: `length` raw bytes,
+ * - CRC: The little-endian CRC32 of the preceding bytes of the frame.
+ *
+ * Frames with a bad length or CRC are answered with an error status and
+ * dropped, and the host is expected to resend. The payload and CRC of a frame
+ * that is too long are read and dropped before answering so that the next
+ * frame starts on a frame boundary. A CRC mismatch may come from a corrupted
+ * length, so the rest of the RX FIFO is dropped as well in that case.
+ *
+ * @param[out] cmd Simple serial command.
+ * @param[out] data Buffer for received packet payload.
+ * @param data_buf_len Length of the packet payload buffer.
+ * @param[out] data_len Received packet payload length.
+ */
+static void simple_serial_receive_frame(uint8_t *cmd, uint8_t *data,
+                                        size_t data_buf_len,
+                                        size_t *data_len) {
+  while (true) {
+    uint8_t header[2];
+    uint8_t crc[sizeof(uint32_t)];
+    simple_serial_receive_bytes(header, sizeof(header));
+    if (header[1] > data_buf_len) {
+      simple_serial_skip_bytes(header[1] + sizeof(crc));
+      simple_serial_send_status(kSimpleSerialError);
+      continue;
+    }
+    simple_serial_receive_bytes(data, header[1]);
+    simple_serial_receive_bytes(crc, sizeof(crc));
+
+    uint32_t ctx;
+    crc32_init(&ctx);
+    crc32_add(&ctx, header, sizeof(header));
+    crc32_add(&ctx, data, header[1]);
+    if (crc32_finish(&ctx) == read_32(crc)) {
+      *cmd = header[0];
+      *data_len = header[1];
+      return;
+    }
+    IGNORE_RESULT(dif_uart_fifo_reset(uart, kDifUartDatapathRx));
+    simple_serial_send_status(kSimpleSerialError);
+  }
+}
+
+/**
+ * Sends a binary framed simple serial packet over UART.
+ *
+ * See `simple_serial_receive_frame()` for the frame format.
+ *
+ * @param cmd Simple serial command.
+ * @param data Packet payload.
+ * @param data_len Payload length, at most `kBinaryFrameMaxPayload`.
+ */
+static void simple_serial_send_frame(uint8_t cmd, const uint8_t *data,
+                                     size_t data_len) {
+  uint8_t header[2] = {cmd, (uint8_t)data_len};
+  uint32_t ctx;
+  crc32_init(&ctx);
+  crc32_add(&ctx, header, sizeof(header));
+  crc32_add(&ctx, data, data_len);
+  uint8_t crc[sizeof(uint32_t)];
+  write_32(crc32_finish(&ctx), crc);
+
+  simple_serial_send_bytes(header, sizeof(header));
+  simple_serial_send_bytes(data, data_len);
+  simple_serial_send_bytes(crc, sizeof(crc));
+}
+
 /**
  * Returns the index of a command's handler in `handlers`.
  *
@@ -141,22 +282,43 @@ static size_t simple_serial_get_handler_index(uint8_t cmd) {
  * useful for checking that the host and the device can communicate properly
  * before starting capturing traces.
  *
+ * The host can also use this command to select the framing of all subsequent
+ * packets by sending the requested version as a single byte payload:
+ * `kSimpleSerialProtocolVersionBinary` selects binary frames and
+ * `kSimpleSerialProtocolVersion` selects the default text packets. The reply
+ * is sent using the previous framing and carries the version now in use, so
+ * hosts that do not know about binary framing see no change.
+ *
  * @param data Received packet payload.
  * @param data_len Payload length.
  */
 static void simple_serial_version(const uint8_t *data, size_t data_len) {
-  simple_serial_send_status(kSimpleSerialProtocolVersion);
+  simple_serial_framing_t next = framing;
+  if (data_len == 1 && data[0] == kSimpleSerialProtocolVersionBinary) {
+    next = kSimpleSerialFramingBinary;
+  } else if (data_len == 1 && data[0] == kSimpleSerialProtocolVersion) {
+    next = kSimpleSerialFramingText;
+  }
+  simple_serial_send_status(next == kSimpleSerialFramingBinary
+                                ? kSimpleSerialProtocolVersionBinary
+                                : kSimpleSerialProtocolVersion);
+  framing = next;
 }
 
 /**
  * Simple serial 's' (seed PRNG) command handler.
  *
- * This function only supports 4-byte seeds.
+ * A 4-byte seed selects the default Mersenne Twister PRNG. A 5-byte payload
+ * holds a 4-byte seed followed by a `prng_algorithm_t` value.
  *
  * @param seed A buffer holding the seed.
  * @param seed_len Seed length.
  */
 static void simple_serial_seed_prng(const uint8_t *seed, size_t seed_len) {
+  if (seed_len == sizeof(uint32_t) + 1) {
+    SS_CHECK(prng_seed_algorithm(seed[sizeof(uint32_t)], read_32(seed)));
+    return;
+  }
   SS_CHECK(seed_len == sizeof(uint32_t));
   prng_seed(read_32(seed));
 }
@@ -176,6 +338,7 @@ static void simple_serial_unknown_command(const uint8_t *data,
 
 void simple_serial_init(const dif_uart_t *uart_) {
   uart = uart_;
+  framing = kSimpleSerialFramingText;
 
   for (size_t i = 0; i < ARRAYSIZE(handlers); ++i) {
     handlers[i] = simple_serial_unknown_command;
@@ -201,12 +364,28 @@ void simple_serial_process_packet(void) {
   uint8_t cmd;
   uint8_t data[kUartMaxRxPacketSize];
   size_t data_len;
-  simple_serial_receive_packet(&cmd, data, ARRAYSIZE(data), &data_len);
+  if (framing == kSimpleSerialFramingBinary) {
+    simple_serial_receive_frame(&cmd, data, ARRAYSIZE(data), &data_len);
+  } else {
+    simple_serial_receive_packet(&cmd, data, ARRAYSIZE(data), &data_len);
+  }
   handlers[simple_serial_get_handler_index(cmd)](data, data_len);
 }
 
 void simple_serial_send_packet(const uint8_t cmd, const uint8_t *data,
                                size_t data_len) {
+  if (framing == kSimpleSerialFramingBinary) {
+    // Longer payloads are split into consecutive frames with the same command.
+    do {
+      size_t len = data_len < kBinaryFrameMaxPayload ? data_len
+                                                     : kBinaryFrameMaxPayload;
+      simple_serial_send_frame(cmd, data, len);
+      data += len;
+      data_len -= len;
+    } while (data_len > 0);
+    return;
+  }
+
   char buf;
   base_snprintf(&buf, 1, "%c", cmd);
   IGNORE_RESULT(dif_uart_byte_send_polled(uart, buf));
@@ -21,6 +21,11 @@
  * can implement additional command by registering their handlers using
  * `simple_serial_register_handler()`. See https://wiki.newae.com/SimpleSerial
  * for details on the protocol.
+ *
+ * Hosts can switch to a faster binary framing, with a length byte, raw
+ * payload and a CRC32 in place of the hex encoded payload, by sending a 'v'
+ * command with the single byte payload 0x02. The same handlers serve both
+ * framings.
  */
 
 /**
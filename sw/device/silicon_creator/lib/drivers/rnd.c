@@ -7,6 +7,7 @@
 #include "sw/device/lib/base/csr.h"
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/random_order.h"
 #include "sw/device/silicon_creator/lib/crc32.h"
 #include "sw/device/silicon_creator/lib/drivers/otp.h"
 
@@ -116,3 +117,14 @@ uint32_t rnd_uint32(void) {
   CSR_READ(CSR_REG_MCYCLE, &mcycle);
   return mcycle + abs_mmio_read32(kBaseIbex + RV_CORE_IBEX_RND_DATA_REG_OFFSET);
 }
+
+// Seed the random orders of the hardened memory functions from RND_DATA
+// instead of only the cycle counter. This runs on every hardened_mem*() call,
+// so unlike `rnd_uint32()` it neither reads OTP nor waits for RND_DATA to be
+// refreshed: a stale value is good enough to pick a traversal order, and the
+// call must not hang when EDN is not running.
+uint32_t random_order_random_word(void) {
+  uint32_t mcycle;
+  CSR_READ(CSR_REG_MCYCLE, &mcycle);
+  return mcycle + abs_mmio_read32(kBaseIbex + RV_CORE_IBEX_RND_DATA_REG_OFFSET);
+}
@@ -9,6 +9,7 @@
 #include "gtest/gtest.h"
 #include "sw/device/lib/base/csr.h"
 #include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/lib/base/random_order.h"
 #include "sw/device/silicon_creator/lib/base/mock_csr.h"
 #include "sw/device/silicon_creator/lib/base/mock_sec_mmio.h"
 #include "sw/device/silicon_creator/lib/drivers/mock_otp.h"
@@ -59,6 +60,13 @@ TEST_F(RndTest, GetUint32Disabled) {
   EXPECT_EQ(rnd_uint32(), 978465 + 193475837);
 }
 
+TEST_F(RndTest, RandomOrderRandomWord) {
+  // No OTP read and no wait for RND_STATUS.
+  EXPECT_CSR_READ(CSR_REG_MCYCLE, 4321);
+  EXPECT_ABS_READ32(base_rv_ + RV_CORE_IBEX_RND_DATA_REG_OFFSET, 8765);
+  EXPECT_EQ(random_order_random_word(), 4321 + 8765);
+}
+
 struct RndtLcStateTestCfg {
   lifecycle_state_t lc_state;
   bool expect_error_ok;
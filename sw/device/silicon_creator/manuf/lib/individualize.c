@@ -143,9 +143,9 @@ static status_t hw_cfg_enable_knobs_set(const dif_otp_ctrl_t *otp) {
   val = bitfield_field32_write(val, kEntropySrcFwOvr,
                                kHwCfgSettings.en_entropy_src_fw_over);
 
-  TRY(otp_ctrl_testutils_dai_write32(otp, kDifOtpCtrlPartitionHwCfg,
-                                     kHwCfgEnSramIfetchOffset, &val,
-                                     /*len=*/1));
+  TRY(otp_ctrl_testutils_dai_write_range(otp, kDifOtpCtrlPartitionHwCfg,
+                                         kHwCfgEnSramIfetchOffset, &val,
+                                         /*len=*/1, /*word_failed=*/NULL));
   return OK_STATUS();
 }
 
@@ -223,9 +223,9 @@ status_t individualize_dev_hw_cfg_start(dif_flash_ctrl_state_t *flash_state,
   TRY(flash_info_read(flash_state, kFlashInfoDeviceIdByteAddress,
                       kFlashInfoDeviceIdPartitionId, kFlashInfoDeviceIdPageId,
                       device_id, kFlashInfoDeviceIdWordCount));
-  TRY(otp_ctrl_testutils_dai_write32(otp, kDifOtpCtrlPartitionHwCfg,
-                                     kHwCfgDeviceIdOffset, device_id,
-                                     kHwCfgDeviceIdWordCount));
+  TRY(otp_ctrl_testutils_dai_write_range(
+      otp, kDifOtpCtrlPartitionHwCfg, kHwCfgDeviceIdOffset, device_id,
+      kHwCfgDeviceIdWordCount, /*word_failed=*/NULL));
 
   // Configure ManufState
   uint32_t manuf_state[kFlashInfoManufStateWordCount];
@@ -233,9 +233,9 @@ status_t individualize_dev_hw_cfg_start(dif_flash_ctrl_state_t *flash_state,
                       kFlashInfoManufStatePartitionId,
                       kFlashInfoManufStatePageId, manuf_state,
                       kFlashInfoManufStateWordCount));
-  TRY(otp_ctrl_testutils_dai_write32(otp, kDifOtpCtrlPartitionHwCfg,
-                                     kHwCfgManufStateOffset, manuf_state,
-                                     kHwCfgManufStateWordCount));
+  TRY(otp_ctrl_testutils_dai_write_range(
+      otp, kDifOtpCtrlPartitionHwCfg, kHwCfgManufStateOffset, manuf_state,
+      kHwCfgManufStateWordCount, /*word_failed=*/NULL));
 
   TRY(otp_ctrl_testutils_lock_partition(otp, kDifOtpCtrlPartitionHwCfg,
                                         /*digest=*/0));
@@ -282,8 +282,10 @@ status_t otp_secret_write(const dif_otp_ctrl_t *otp, uint32_t offset,
     return INTERNAL();
   }
 
-  TRY(otp_ctrl_testutils_dai_write64(otp, kDifOtpCtrlPartitionSecret1, offset,
-                                     data, len));
+  TRY(otp_ctrl_testutils_dai_write_range(otp, kDifOtpCtrlPartitionSecret1,
+                                         offset, (const uint32_t *)data,
+                                         len_in_32bit_words,
+                                         /*word_failed=*/NULL));
   return OK_STATUS();
 }
 
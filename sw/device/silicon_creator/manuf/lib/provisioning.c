@@ -199,12 +199,14 @@ static status_t otp_partition_secret2_configure(const dif_otp_ctrl_t *otp) {
 
   TRY(shares_check(share0, share1, kRootKeyShareSizeIn64BitWords));
 
-  TRY(otp_ctrl_testutils_dai_write64(otp, kDifOtpCtrlPartitionSecret2,
-                                     kRootKeyOffsetShare0, share0,
-                                     kRootKeyShareSizeIn64BitWords));
-  TRY(otp_ctrl_testutils_dai_write64(otp, kDifOtpCtrlPartitionSecret2,
-                                     kRootKeyOffsetShare1, share1,
-                                     kRootKeyShareSizeIn64BitWords));
+  TRY(otp_ctrl_testutils_dai_write_range(
+      otp, kDifOtpCtrlPartitionSecret2, kRootKeyOffsetShare0,
+      (const uint32_t *)share0, kRootKeyShareSizeIn32BitWords,
+      /*word_failed=*/NULL));
+  TRY(otp_ctrl_testutils_dai_write_range(
+      otp, kDifOtpCtrlPartitionSecret2, kRootKeyOffsetShare1,
+      (const uint32_t *)share1, kRootKeyShareSizeIn32BitWords,
+      /*word_failed=*/NULL));
   TRY(shares_check(share0, share1, kRootKeyShareSizeIn64BitWords));
 
   TRY(otp_ctrl_testutils_lock_partition(otp, kDifOtpCtrlPartitionSecret2,
@@ -0,0 +1,97 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/crypto/drivers/hmac.h"
+#include "sw/device/lib/crypto/drivers/otbn.h"
+#include "sw/device/lib/crypto/impl/ecc/ecdsa_p256.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/entropy_testutils.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+// Messages of different lengths, including an empty one.
+static const char kMessage0[] = "test message";
+static const char kMessage1[] = "";
+static const char kMessage2[] =
+    "a longer test message that spans more than one SHA-256 block, so that "
+    "hashing it takes a little while";
+
+static const ecdsa_p256_message_t kMessages[] = {
+    {.data = (const uint8_t *)kMessage0, .len = sizeof(kMessage0) - 1},
+    {.data = (const uint8_t *)kMessage1, .len = sizeof(kMessage1) - 1},
+    {.data = (const uint8_t *)kMessage2, .len = sizeof(kMessage2) - 1},
+};
+
+enum {
+  kNumMessages = ARRAYSIZE(kMessages),
+};
+
+static void compute_digest(const ecdsa_p256_message_t *message,
+                           hmac_digest_t *digest) {
+  // Compute the SHA-256 digest using the HMAC device.
+  hmac_sha256_init();
+  hmac_update(message->data, message->len);
+  hmac_final(digest);
+}
+
+status_t sign_batch_then_verify_test(void) {
+  // Generate a keypair.
+  LOG_INFO("Generating keypair...");
+  p256_masked_scalar_t private_key;
+  p256_point_t public_key;
+  TRY(ecdsa_p256_keygen_start());
+  TRY(ecdsa_p256_keygen_finalize(&private_key, &public_key));
+
+  // Sign all messages in one batch.
+  LOG_INFO("Signing %d messages...", kNumMessages);
+  ecdsa_p256_signature_t signatures[kNumMessages];
+  TRY(ecdsa_p256_sign_batch(kMessages, kNumMessages, &private_key,
+                            signatures));
+
+  // Verify each signature against its own message.
+  for (size_t i = 0; i < kNumMessages; ++i) {
+    LOG_INFO("Verifying signature %d...", i);
+    hmac_digest_t digest;
+    compute_digest(&kMessages[i], &digest);
+    TRY(ecdsa_p256_verify_start(&signatures[i], digest.digest, &public_key));
+    hardened_bool_t result;
+    TRY(ecdsa_p256_verify_finalize(&signatures[i], &result));
+    if (result != kHardenedBoolTrue) {
+      LOG_ERROR("Signature %d failed verification.", i);
+      return OTCRYPTO_RECOV_ERR;
+    }
+  }
+
+  // A signature must not verify against a different message.
+  hmac_digest_t digest;
+  compute_digest(&kMessages[1], &digest);
+  TRY(ecdsa_p256_verify_start(&signatures[0], digest.digest, &public_key));
+  hardened_bool_t result;
+  TRY(ecdsa_p256_verify_finalize(&signatures[0], &result));
+  if (result != kHardenedBoolFalse) {
+    LOG_ERROR("Signature 0 passed verification for message 1.");
+    return OTCRYPTO_RECOV_ERR;
+  }
+
+  return OTCRYPTO_OK;
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_testutils_auto_mode_init());
+
+  status_t err = sign_batch_then_verify_test();
+  if (!status_ok(err)) {
+    // If there was an error, print the OTBN error bits and instruction count.
+    LOG_INFO("OTBN error bits: 0x%08x", otbn_err_bits_get());
+    LOG_INFO("OTBN instruction count: 0x%08x", otbn_instruction_count_get());
+    // Print the error.
+    CHECK_STATUS_OK(err);
+    return false;
+  }
+
+  return true;
+}
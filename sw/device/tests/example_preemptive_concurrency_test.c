@@ -0,0 +1,82 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * This example demonstrates a concurrency test that relies on the preemptive
+ * OTTF configuration, so it is only built with `--config=ottf_preemptive`.
+ *
+ * Two worker tasks of equal priority spin without ever yielding, each until
+ * it observes that the other one has also run. This can only complete if the
+ * scheduler time slices between them. The workers are created by a
+ * higher-priority collector task, so that they only start once it blocks
+ * waiting for their notifications. Once all tasks are done, the `test_main`
+ * task logs the CPU time spent in each task.
+ */
+
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_macros.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+#if !configUSE_PREEMPTION
+#error "This test requires --config=ottf_preemptive."
+#endif  // !configUSE_PREEMPTION
+
+OTTF_DEFINE_TEST_CONFIG(.enable_concurrency = true);
+
+enum {
+  kNumWorkers = 2,
+  kCollectorTimeoutMs = 1000,
+};
+
+static volatile uint32_t worker_iterations[kNumWorkers];
+static volatile uint32_t notifications_received;
+static ottf_task_handle_t collector;
+
+static void worker(size_t id) {
+  LOG_INFO("Executing %s ...", ottf_task_get_self_name());
+  size_t other = (id + 1) % kNumWorkers;
+  // Spin until the other worker has made progress. Neither worker yields, so
+  // this relies on the tick interrupt switching between them.
+  while (worker_iterations[other] == 0) {
+    ++worker_iterations[id];
+  }
+  ++worker_iterations[id];
+  CHECK(ottf_task_notify(collector));
+  OTTF_TASK_DELETE_SELF_OR_DIE;
+}
+
+static void worker_0(void *task_parameters) { worker(0); }
+
+static void worker_1(void *task_parameters) { worker(1); }
+
+static void collector_task(void *task_parameters) {
+  collector = ottf_task_get_handle("collector");
+  CHECK(collector != NULL);
+  CHECK(ottf_task_create(worker_0, "worker_0", kOttfFreeRtosMinStackSize, 1));
+  CHECK(ottf_task_create(worker_1, "worker_1", kOttfFreeRtosMinStackSize, 1));
+
+  while (notifications_received < kNumWorkers) {
+    uint32_t notifications = ottf_task_notify_wait(kCollectorTimeoutMs);
+    CHECK(notifications > 0, "Timed out waiting for the workers.");
+    notifications_received += notifications;
+  }
+  OTTF_TASK_DELETE_SELF_OR_DIE;
+}
+
+bool test_main(void) {
+  CHECK(ottf_task_create(collector_task, "collector", kOttfFreeRtosMinStackSize,
+                         2));
+
+  // The `test_main` task has the lowest priority, so it only continues once
+  // all other tasks have deleted themselves.
+  ottf_task_yield();
+
+  CHECK(notifications_received == kNumWorkers);
+  for (size_t i = 0; i < kNumWorkers; ++i) {
+    LOG_INFO("worker_%u: %u iterations", (uint32_t)i, worker_iterations[i]);
+  }
+  CHECK(ottf_task_log_runtime_stats());
+  return true;
+}
@@ -0,0 +1,262 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Measures the interrupt latency and ISR overhead of the OTTF, in CPU cycles.
+ *
+ * Interrupts are triggered from software, through the INTR_TEST registers of
+ * two sources:
+ * - rv_timer, which is wired directly to the Ibex timer interrupt, and
+ * - gpio, which is routed through the rv_plic to the Ibex external interrupt,
+ *   and must be claimed and completed by the handler.
+ *
+ * The low word of `mcycle` is read just before the interrupt is triggered, on
+ * entry to the C handler, and once control returns to the interrupted code.
+ * When the OTTF is built with `--config=ottf_isr_timestamps`, the OTTF ISR
+ * assembly also records timestamps on entry, before calling the C handler,
+ * and on exit, which breaks the latency down further.
+ *
+ * For each measurement, the minimum, average and maximum are logged, along
+ * with a histogram with power-of-two buckets.
+ */
+
+#include "sw/device/lib/base/csr.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/dif/dif_gpio.h"
+#include "sw/device/lib/dif/dif_rv_plic.h"
+#include "sw/device/lib/dif/dif_rv_timer.h"
+#include "sw/device/lib/runtime/irq.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_isrs.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  /**
+   * Number of interrupts triggered per source.
+   */
+  kNumSamples = 64,
+  /**
+   * Number of histogram buckets. Bucket `i` counts samples in
+   * `[2^i, 2^(i+1))` cycles, except that the first bucket also counts zero,
+   * and the last bucket also counts all larger samples.
+   */
+  kNumBuckets = 12,
+  kPlicTarget = kTopEarlgreyPlicTargetIbex0,
+  kGpioPlicIrqId = kTopEarlgreyPlicIrqIdGpioGpio0,
+};
+
+/**
+ * Latency statistics for one measurement, in cycles.
+ */
+typedef struct latency_stats {
+  const char *name;
+  uint32_t min;
+  uint32_t max;
+  uint32_t sum;
+  uint32_t count;
+  uint32_t buckets[kNumBuckets];
+} latency_stats_t;
+
+/**
+ * Measurements taken for each interrupt source.
+ */
+typedef struct irq_stats {
+  /**
+   * From triggering the interrupt to entering the C handler.
+   */
+  latency_stats_t to_handler;
+  /**
+   * From entering the C handler to returning to the interrupted code.
+   */
+  latency_stats_t to_return;
+  /**
+   * From triggering the interrupt to entering the assembly handler.
+   */
+  latency_stats_t to_entry;
+  /**
+   * From entering the assembly handler to calling the C handler.
+   */
+  latency_stats_t context_save;
+  /**
+   * From the C handler returning to returning to the interrupted code.
+   */
+  latency_stats_t context_restore;
+} irq_stats_t;
+
+static dif_rv_timer_t timer;
+static dif_gpio_t gpio;
+static dif_rv_plic_t plic;
+
+static volatile bool irq_handled;
+static volatile uint32_t handler_cycles;
+static volatile dif_rv_plic_irq_id_t claimed_irq_id;
+
+static uint32_t mcycle_read(void) {
+  uint32_t cycles;
+  CSR_READ(CSR_REG_MCYCLE, &cycles);
+  return cycles;
+}
+
+static void stats_init(latency_stats_t *stats, const char *name) {
+  *stats = (latency_stats_t){
+      .name = name,
+      .min = UINT32_MAX,
+  };
+}
+
+static void stats_add(latency_stats_t *stats, uint32_t cycles) {
+  if (cycles < stats->min) {
+    stats->min = cycles;
+  }
+  if (cycles > stats->max) {
+    stats->max = cycles;
+  }
+  stats->sum += cycles;
+  ++stats->count;
+
+  size_t bucket = 0;
+  while (bucket < kNumBuckets - 1 && (cycles >> (bucket + 1)) != 0) {
+    ++bucket;
+  }
+  ++stats->buckets[bucket];
+}
+
+static void stats_log(const latency_stats_t *stats) {
+  if (stats->count == 0) {
+    return;
+  }
+  LOG_INFO("%s: min = %u, avg = %u, max = %u cycles", stats->name, stats->min,
+           stats->sum / stats->count, stats->max);
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    if (stats->buckets[i] != 0) {
+      LOG_INFO("  [%u, %u): %u", i == 0 ? 0 : (uint32_t)(1u << i),
+               i == kNumBuckets - 1 ? UINT32_MAX : (uint32_t)(2u << i),
+               stats->buckets[i]);
+    }
+  }
+}
+
+static void irq_stats_init(irq_stats_t *stats) {
+  stats_init(&stats->to_handler, "trigger to C handler");
+  stats_init(&stats->to_return, "C handler to return");
+  stats_init(&stats->to_entry, "trigger to ISR entry");
+  stats_init(&stats->context_save, "ISR entry to C handler");
+  stats_init(&stats->context_restore, "C handler exit to return");
+}
+
+static void irq_stats_log(const irq_stats_t *stats) {
+  stats_log(&stats->to_handler);
+  stats_log(&stats->to_return);
+  stats_log(&stats->to_entry);
+  stats_log(&stats->context_save);
+  stats_log(&stats->context_restore);
+}
+
+/**
+ * Triggers one interrupt with `trigger` and records its latencies.
+ */
+static void measure_irq(irq_stats_t *stats, void (*trigger)(void)) {
+  irq_handled = false;
+  uint32_t trigger_cycles = mcycle_read();
+  trigger();
+  // Spin rather than wait for interrupt, so that the measurement does not
+  // include the wake-up time of the core.
+  while (!irq_handled) {
+  }
+  uint32_t return_cycles = mcycle_read();
+
+  stats_add(&stats->to_handler, handler_cycles - trigger_cycles);
+  stats_add(&stats->to_return, return_cycles - handler_cycles);
+#ifdef OTTF_ISR_TIMESTAMPS
+  stats_add(&stats->to_entry, ottf_isr_timestamps.entry - trigger_cycles);
+  stats_add(&stats->context_save,
+            ottf_isr_timestamps.handler - ottf_isr_timestamps.entry);
+  stats_add(&stats->context_restore,
+            return_cycles - ottf_isr_timestamps.exit);
+#endif  // OTTF_ISR_TIMESTAMPS
+}
+
+static void timer_trigger(void) {
+  CHECK_DIF_OK(dif_rv_timer_irq_force(
+      &timer, kDifRvTimerIrqTimerExpiredHart0Timer0, true));
+}
+
+static void gpio_trigger(void) {
+  CHECK_DIF_OK(dif_gpio_irq_force(&gpio, kDifGpioIrqGpio0, true));
+}
+
+// Override the default OTTF timer ISR.
+void ottf_timer_isr(void) {
+  handler_cycles = mcycle_read();
+  CHECK_DIF_OK(dif_rv_timer_irq_acknowledge(
+      &timer, kDifRvTimerIrqTimerExpiredHart0Timer0));
+  irq_handled = true;
+}
+
+// Override the default OTTF external ISR.
+void ottf_external_isr(void) {
+  handler_cycles = mcycle_read();
+  dif_rv_plic_irq_id_t irq_id;
+  CHECK_DIF_OK(dif_rv_plic_irq_claim(&plic, kPlicTarget, &irq_id));
+  claimed_irq_id = irq_id;
+  CHECK_DIF_OK(dif_gpio_irq_acknowledge(&gpio, kDifGpioIrqGpio0));
+  CHECK_DIF_OK(dif_rv_plic_irq_complete(&plic, kPlicTarget, irq_id));
+  irq_handled = true;
+}
+
+bool test_main(void) {
+  CHECK_DIF_OK(dif_rv_timer_init(
+      mmio_region_from_addr(TOP_EARLGREY_RV_TIMER_BASE_ADDR), &timer));
+  CHECK_DIF_OK(dif_rv_timer_reset(&timer));
+  CHECK_DIF_OK(dif_rv_timer_irq_set_enabled(
+      &timer, kDifRvTimerIrqTimerExpiredHart0Timer0, kDifToggleEnabled));
+
+  CHECK_DIF_OK(
+      dif_gpio_init(mmio_region_from_addr(TOP_EARLGREY_GPIO_BASE_ADDR), &gpio));
+  CHECK_DIF_OK(dif_gpio_irq_set_enabled(&gpio, kDifGpioIrqGpio0,
+                                        kDifToggleEnabled));
+
+  CHECK_DIF_OK(dif_rv_plic_init(
+      mmio_region_from_addr(TOP_EARLGREY_RV_PLIC_BASE_ADDR), &plic));
+  CHECK_DIF_OK(dif_rv_plic_irq_set_priority(&plic, kGpioPlicIrqId,
+                                            kDifRvPlicMaxPriority));
+  CHECK_DIF_OK(dif_rv_plic_target_set_threshold(&plic, kPlicTarget,
+                                                kDifRvPlicMinPriority));
+  CHECK_DIF_OK(dif_rv_plic_irq_set_enabled(&plic, kGpioPlicIrqId, kPlicTarget,
+                                           kDifToggleEnabled));
+
+  irq_global_ctrl(true);
+  irq_timer_ctrl(true);
+  irq_external_ctrl(true);
+
+#ifndef OTTF_ISR_TIMESTAMPS
+  LOG_INFO("Build with --config=ottf_isr_timestamps for a latency breakdown.");
+#endif  // OTTF_ISR_TIMESTAMPS
+
+  static irq_stats_t timer_stats;
+  irq_stats_init(&timer_stats);
+  for (size_t i = 0; i < kNumSamples; ++i) {
+    measure_irq(&timer_stats, timer_trigger);
+  }
+  LOG_INFO("rv_timer interrupt latency:");
+  irq_stats_log(&timer_stats);
+
+  static irq_stats_t gpio_stats;
+  irq_stats_init(&gpio_stats);
+  for (size_t i = 0; i < kNumSamples; ++i) {
+    measure_irq(&gpio_stats, gpio_trigger);
+    CHECK(claimed_irq_id == kGpioPlicIrqId, "Unexpected PLIC IRQ ID: %u",
+          claimed_irq_id);
+  }
+  LOG_INFO("gpio interrupt latency, through rv_plic:");
+  irq_stats_log(&gpio_stats);
+
+  return true;
+}
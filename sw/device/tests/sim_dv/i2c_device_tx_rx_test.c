@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/dif/dif_base.h"
 #include "sw/device/lib/dif/dif_i2c.h"
@@ -70,6 +71,14 @@ static volatile const uint8_t kI2cByteCount = 0;
 static volatile bool tx_empty_irq_seen = false;
 static volatile bool cmd_complete_irq_seen = false;
 
+/**
+ * The transfer that drains the ACQ FIFO from the ISR, and whether it is
+ * complete.
+ */
+static i2c_testutils_fifo_xfer_t acq_xfer;
+static volatile bool acq_xfer_active = false;
+static volatile bool acq_xfer_done = false;
+
 /**
  * This constant indicates the number of interrupt requests.
  */
@@ -139,6 +148,13 @@ void ottf_external_isr(void) {
     case kDifI2cIrqCmdComplete:
       cmd_complete_irq_seen = true;
       i2c_irq = kDifI2cIrqCmdComplete;
+      OT_FALLTHROUGH_INTENDED;
+    case kDifI2cIrqAcqFull:
+      if (acq_xfer_active) {
+        acq_xfer_done =
+            UNWRAP(i2c_testutils_fifo_xfer_service(&i2c, &acq_xfer));
+        acq_xfer_active = !acq_xfer_done;
+      }
       break;
     default:
       LOG_ERROR("Unexpected interrupt (at I2C): %d", i2c_irq);
@@ -245,20 +261,36 @@ bool test_main(void) {
 
   // Read data from i2c device.
   CHECK_STATUS_OK(i2c_testutils_target_wr(&i2c, kI2cByteCount));
-  do {
-    CHECK_DIF_OK(
-        dif_i2c_get_fifo_levels(&i2c, NULL, NULL, &tx_fifo_lvl, &acq_fifo_lvl));
-  } while (acq_fifo_lvl < kI2cByteCount + 2);  // acquired message, address and
-                                               // junk
 
-  uint8_t received_data[kI2cByteCount];
-  CHECK_STATUS_OK(i2c_testutils_target_check_wr(&i2c, kI2cByteCount, &addr,
-                                                received_data, NULL));
-  check_addr(addr, id0, id1);
+  // Drain the START with the address, the data and the STOP from the ISR.
+  // This is less than a full ACQ FIFO, so the transfer completes on
+  // `kDifI2cIrqCmdComplete`.
+  uint8_t acq_data[kI2cByteCount + 2];
+  dif_i2c_signal_t acq_signals[kI2cByteCount + 2];
+  acq_xfer = (i2c_testutils_fifo_xfer_t){
+      .fifo = kI2cTestutilsFifoAcq,
+      .dst = acq_data,
+      .signals = acq_signals,
+      .len = kI2cByteCount + 2,
+  };
+  irq_global_ctrl(false);
+  acq_xfer_done = UNWRAP(i2c_testutils_fifo_xfer_start(&i2c, &acq_xfer));
+  acq_xfer_active = !acq_xfer_done;
+  while (!acq_xfer_done) {
+    wait_for_interrupt();
+    irq_global_ctrl(true);
+    irq_global_ctrl(false);
+  }
+  irq_global_ctrl(true);
 
+  CHECK(acq_signals[0] == kDifI2cSignalStart);
+  CHECK((acq_data[0] & 1) == 0, "Expected a write");
+  check_addr(acq_data[0] >> 1, id0, id1);
   for (uint8_t i = 0; i < kI2cByteCount; ++i) {
-    CHECK(expected_data[i] == received_data[i]);
+    CHECK(acq_signals[i + 1] == kDifI2cSignalNone);
+    CHECK(expected_data[i] == acq_data[i + 1]);
   }
+  CHECK(acq_signals[kI2cByteCount + 1] == kDifI2cSignalStop);
 
   CHECK(cmd_complete_irq_seen);
 
@@ -0,0 +1,240 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/dif/dif_rv_plic.h"
+#include "sw/device/lib/dif/dif_spi_host.h"
+#include "sw/device/lib/runtime/hart.h"
+#include "sw/device/lib/runtime/irq.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/rv_plic_testutils.h"
+#include "sw/device/lib/testing/spi_device_testutils.h"
+#include "sw/device/lib/testing/spi_flash_testutils.h"
+#include "sw/device/lib/testing/spi_host_async.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  kHart = kTopEarlgreyPlicTargetIbex0,
+  /**
+   * Size of the SFDP region read by the test.
+   */
+  kSfdpSize = 256,
+  /**
+   * Number of back-to-back transactions the SFDP region is read with.
+   */
+  kSfdpChunks = 4,
+  kSfdpChunkSize = kSfdpSize / kSfdpChunks,
+};
+
+static dif_spi_host_t spi_host;
+static dif_rv_plic_t plic;
+static spi_host_async_t async;
+
+/**
+ * Declared volatile because they are referenced in the main program flow as
+ * well as the ISR.
+ */
+// The first error seen by the ISR.
+static volatile status_t isr_result;
+// The number of SPI Host event interrupts serviced.
+static volatile uint32_t irq_count;
+
+/**
+ * Services the asynchronous transaction engine from the SPI Host event
+ * interrupt.
+ */
+static status_t external_isr(void) {
+  dif_rv_plic_irq_id_t plic_irq_id;
+  TRY(dif_rv_plic_irq_claim(&plic, kHart, &plic_irq_id));
+
+  top_earlgrey_plic_peripheral_t peripheral = (top_earlgrey_plic_peripheral_t)
+      top_earlgrey_plic_interrupt_for_peripheral[plic_irq_id];
+  TRY_CHECK(peripheral == kTopEarlgreyPlicPeripheralSpiHost0,
+            "IRQ from incorrect peripheral: exp = %d(spi_host0), found = %d",
+            kTopEarlgreyPlicPeripheralSpiHost0, peripheral);
+  TRY_CHECK(plic_irq_id == kTopEarlgreyPlicIrqIdSpiHost0SpiEvent,
+            "Unexpected IRQ: %d", plic_irq_id);
+
+  TRY(dif_spi_host_irq_acknowledge(&spi_host, kDifSpiHostIrqSpiEvent));
+  ++irq_count;
+  status_t result = spi_host_async_service(&async);
+
+  // Complete the IRQ at PLIC.
+  TRY(dif_rv_plic_irq_complete(&plic, kHart, plic_irq_id));
+  return result;
+}
+
+void ottf_external_isr(void) {
+  status_t result = external_isr();
+  if (status_ok(isr_result)) {
+    isr_result = result;
+  }
+}
+
+/**
+ * Queues a transaction with the event interrupt masked, as required by
+ * `spi_host_async_enqueue()`.
+ */
+static status_t enqueue(spi_host_async_txn_t *txn) {
+  irq_global_ctrl(false);
+  status_t result = spi_host_async_enqueue(&async, txn);
+  irq_global_ctrl(true);
+  return result;
+}
+
+/**
+ * Sleeps until the ISR has completed all queued transactions.
+ */
+static status_t wait_for_idle(void) {
+  irq_global_ctrl(false);
+  while (!spi_host_async_is_idle(&async) && status_ok(isr_result)) {
+    wait_for_interrupt();
+    irq_global_ctrl(true);
+    irq_global_ctrl(false);
+  }
+  irq_global_ctrl(true);
+  return isr_result;
+}
+
+typedef struct sfdp_read {
+  spi_host_async_txn_t txn;
+  dif_spi_host_segment_t segments[4];
+} sfdp_read_t;
+
+static void sfdp_read_init(sfdp_read_t *read, uint32_t address, uint8_t *buf,
+                           size_t length) {
+  read->segments[0] = (dif_spi_host_segment_t){
+      .type = kDifSpiHostSegmentTypeOpcode,
+      .opcode = kSpiDeviceFlashOpReadSfdp,
+  };
+  read->segments[1] = (dif_spi_host_segment_t){
+      .type = kDifSpiHostSegmentTypeAddress,
+      .address =
+          {
+              .width = kDifSpiHostWidthStandard,
+              .mode = kDifSpiHostAddrMode3b,
+              .address = address,
+          },
+  };
+  read->segments[2] = (dif_spi_host_segment_t){
+      .type = kDifSpiHostSegmentTypeDummy,
+      .dummy =
+          {
+              .width = kDifSpiHostWidthStandard,
+              .length = 8,
+          },
+  };
+  read->segments[3] = (dif_spi_host_segment_t){
+      .type = kDifSpiHostSegmentTypeRx,
+      .rx =
+          {
+              .width = kDifSpiHostWidthStandard,
+              .buf = buf,
+              .length = length,
+          },
+  };
+  read->txn = (spi_host_async_txn_t){
+      .csid = 0,
+      .segments = read->segments,
+      .length = ARRAYSIZE(read->segments),
+  };
+}
+
+static uint8_t expected[kSfdpSize];
+static uint8_t chunks[kSfdpSize];
+static uint8_t chained[kSfdpSize];
+static sfdp_read_t chunk_reads[kSfdpChunks];
+static sfdp_read_t chained_read;
+static volatile size_t completed;
+
+/**
+ * Checks that transactions complete in order and queues the chained read from
+ * the callback of the last chunk.
+ */
+static void chunk_done(void *arg, spi_host_async_txn_t *txn) {
+  size_t index = (size_t)arg;
+  if (status_ok(isr_result) && index != completed) {
+    isr_result = INTERNAL();
+  }
+  ++completed;
+  if (index == kSfdpChunks - 1) {
+    status_t result = spi_host_async_enqueue(&async, &chained_read.txn);
+    if (status_ok(isr_result)) {
+      isr_result = result;
+    }
+  }
+}
+
+/**
+ * Reads the SFDP region with back-to-back asynchronous transactions, plus one
+ * queued from a completion callback, and compares the data with a
+ * synchronous read.
+ */
+static status_t async_sfdp_read(void) {
+  TRY(spi_flash_testutils_read_sfdp(&spi_host, 0, expected, sizeof(expected)));
+
+  for (size_t i = 0; i < kSfdpChunks; ++i) {
+    sfdp_read_init(&chunk_reads[i], i * kSfdpChunkSize,
+                   &chunks[i * kSfdpChunkSize], kSfdpChunkSize);
+    chunk_reads[i].txn.callback = chunk_done;
+    chunk_reads[i].txn.arg = (void *)i;
+  }
+  sfdp_read_init(&chained_read, 0, chained, sizeof(chained));
+
+  irq_count = 0;
+  completed = 0;
+  for (size_t i = 0; i < kSfdpChunks; ++i) {
+    TRY(enqueue(&chunk_reads[i].txn));
+  }
+  TRY(wait_for_idle());
+
+  LOG_INFO("Serviced %d SPI Host event interrupts", irq_count);
+  TRY_CHECK(irq_count > 0, "Transactions completed without interrupts");
+  TRY_CHECK(completed == kSfdpChunks);
+  TRY_CHECK_ARRAYS_EQ(chunks, expected, sizeof(expected));
+  TRY_CHECK_ARRAYS_EQ(chained, expected, sizeof(expected));
+  return OK_STATUS();
+}
+
+static status_t test_init(void) {
+  TRY(dif_spi_host_init(mmio_region_from_addr(TOP_EARLGREY_SPI_HOST0_BASE_ADDR),
+                        &spi_host));
+  TRY(dif_spi_host_configure(
+      &spi_host, (dif_spi_host_config_t){
+                     .spi_clock = 1000000,
+                     .peripheral_clock_freq_hz = kClockFreqPeripheralHz,
+                     .rx_watermark = 16,
+                     .tx_watermark = 16,
+                 }));
+  TRY(dif_spi_host_output_set_enabled(&spi_host, true));
+  TRY(spi_host_async_init(&spi_host, &async));
+
+  TRY(dif_rv_plic_init(mmio_region_from_addr(TOP_EARLGREY_RV_PLIC_BASE_ADDR),
+                       &plic));
+  rv_plic_testutils_irq_range_enable(&plic, kHart,
+                                     kTopEarlgreyPlicIrqIdSpiHost0SpiEvent,
+                                     kTopEarlgreyPlicIrqIdSpiHost0SpiEvent);
+  TRY(dif_spi_host_irq_set_enabled(&spi_host, kDifSpiHostIrqSpiEvent,
+                                   kDifToggleEnabled));
+
+  isr_result = OK_STATUS();
+  irq_global_ctrl(true);
+  irq_external_ctrl(true);
+  return OK_STATUS();
+}
+
+bool test_main(void) {
+  CHECK_STATUS_OK(test_init());
+  status_t result = OK_STATUS();
+  EXECUTE_TEST(result, async_sfdp_read);
+  return status_ok(result);
+}
@@ -18,9 +18,13 @@
 // propagated unmodified and without data loss, corruption, replication etc.
 
 #include "sw/device/lib/dif/dif_pinmux.h"
+#include "sw/device/lib/dif/dif_rv_plic.h"
+#include "sw/device/lib/runtime/hart.h"
+#include "sw/device/lib/runtime/irq.h"
 #include "sw/device/lib/runtime/log.h"
 #include "sw/device/lib/runtime/print.h"
 #include "sw/device/lib/testing/pinmux_testutils.h"
+#include "sw/device/lib/testing/rv_plic_testutils.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 #include "sw/device/lib/testing/test_framework/ottf_main.h"
 #include "sw/device/lib/testing/usb_testutils.h"
@@ -35,6 +39,12 @@
 #define NUM_STREAMS USBUTILS_STREAMS_MAX
 #endif
 
+// Service the streams from the usbdev interrupts rather than by polling
+// (see the `usbdev_stream_irq_test` target)
+#ifndef USBDEV_STREAM_IRQ_DRIVEN
+#define USBDEV_STREAM_IRQ_DRIVEN 0
+#endif
+
 // This takes about 256s presently with 10MHz CPU in CW310 FPGA and physical
 // USB with randomized packet sizes and the default memcpy implementation;
 // The _MEM_FASTER switch drops the run time to 187s
@@ -122,6 +132,15 @@ static usb_testutils_controlep_ctx_t usbdev_control;
  */
 static dif_pinmux_t pinmux;
 
+/**
+ * PLIC handle
+ */
+static dif_rv_plic_t plic;
+
+enum {
+  kHart = kTopEarlgreyPlicTargetIbex0,
+};
+
 /**
  * State information for streaming data test
  */
@@ -158,6 +177,11 @@ static bool retrying = true;
  */
 static bool recving = true;
 
+/**
+ * Service the streams from the USB device interrupts rather than by polling?
+ */
+static bool irq_driven = USBDEV_STREAM_IRQ_DRIVEN;
+
 /**
  * Send only maximal length packets?
  * (important for performance measurements on the USB, but obviously undesirable
@@ -172,6 +196,23 @@ static const unsigned nstreams = NUM_STREAMS;
 
 OTTF_DEFINE_TEST_CONFIG();
 
+/**
+ * External interrupt handler; services all streams when interrupt-driven.
+ */
+void ottf_external_isr(void) {
+  dif_rv_plic_irq_id_t plic_irq_id;
+  CHECK_DIF_OK(dif_rv_plic_irq_claim(&plic, kHart, &plic_irq_id));
+
+  top_earlgrey_plic_peripheral_t peripheral = (top_earlgrey_plic_peripheral_t)
+      top_earlgrey_plic_interrupt_for_peripheral[plic_irq_id];
+  CHECK(peripheral == kTopEarlgreyPlicPeripheralUsbdev,
+        "IRQ from unexpected peripheral %d", peripheral);
+
+  CHECK_STATUS_OK(usb_testutils_streams_irq_service(&stream_test));
+
+  CHECK_DIF_OK(dif_rv_plic_irq_complete(&plic, kHart, plic_irq_id));
+}
+
 bool test_main(void) {
   // Context state for streaming test
   usb_testutils_streams_ctx_t *ctx = &stream_test;
@@ -240,12 +281,35 @@ bool test_main(void) {
   // Streaming loop; most of the work is done by the usb_testutils_streams base
   //   code and we don't need to specialize its behavior for this test.
   bool done = false;
-  do {
-    CHECK_STATUS_OK(usb_testutils_streams_service(ctx));
-
-    // See whether any streams still have more work to do
-    done = usb_testutils_streams_completed(ctx);
-  } while (!done);
+  if (irq_driven) {
+    CHECK_DIF_OK(dif_rv_plic_init(
+        mmio_region_from_addr(TOP_EARLGREY_RV_PLIC_BASE_ADDR), &plic));
+    rv_plic_testutils_irq_range_enable(&plic, kHart,
+                                       kTopEarlgreyPlicIrqIdUsbdevPktReceived,
+                                       kTopEarlgreyPlicIrqIdUsbdevLinkReset);
+    CHECK_STATUS_OK(usb_testutils_streams_irq_enable(ctx));
+    irq_external_ctrl(true);
+
+    do {
+      // WFI ignores the global interrupt enable, so we can check for
+      // completion without racing the interrupt handler
+      irq_global_ctrl(false);
+      done = usb_testutils_streams_completed(ctx);
+      if (!done) {
+        wait_for_interrupt();
+      }
+      irq_global_ctrl(true);
+    } while (!done);
+
+    irq_external_ctrl(false);
+  } else {
+    do {
+      CHECK_STATUS_OK(usb_testutils_streams_service(ctx));
+
+      // See whether any streams still have more work to do
+      done = usb_testutils_streams_completed(ctx);
+    } while (!done);
+  }
 
   // Determine the total counts of bytes sent and received
   uint32_t tx_bytes = 0U;
@@ -257,6 +321,7 @@ bool test_main(void) {
 
   LOG_INFO("USB sent 0x%x byte(s), received and checked 0x%x byte(s)", tx_bytes,
            rx_bytes);
+  CHECK_STATUS_OK(usb_testutils_streams_report(ctx));
 
   CHECK(tx_bytes == nstreams * transfer_bytes,
         "Unexpected count of byte(s) sent to USB host");
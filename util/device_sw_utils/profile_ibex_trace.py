@@ -0,0 +1,380 @@
+#!/usr/bin/env python3
+# Copyright lowRISC contributors.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+"""Script to build a per-function cycle profile from an Ibex execution trace.
+
+The Ibex tracer logs every retired instruction of a Verilator simulation to
+`trace_core_00000000.log`, along with the cycle count at which it retired.
+This script maps the PC of each instruction to a function using the symbol
+table of the ELF file that was run, and charges each instruction with the
+cycles until the next instruction retired. It produces two reports:
+- a flat profile, with the self and total cycles spent in each function, and
+- a call graph, with the callers and callees of each function.
+
+Calls are recognized as jumps that link to `ra`, and returns as jumps to the
+return address of a call still on the shadow call stack. Jumps to another
+function that are neither are treated as tail calls. Traps are tracked as
+frames that are popped by `mret`. Context switches and `longjmp` are not
+modelled, so the call graph is approximate across them, but the flat profile
+is exact.
+"""
+
+import argparse
+import bisect
+import collections
+import sys
+
+from elftools.elf import elffile
+
+# Mnemonics of instructions that jump and link to `ra`, regardless of their
+# operands.
+LINK_MNEMONICS = {'c.jal', 'c.jalr'}
+# Mnemonics of instructions that jump and link to their destination register.
+JUMP_MNEMONICS = {'jal', 'jalr'}
+# Mnemonics of instructions that raise an exception.
+TRAP_MNEMONICS = {'ecall', 'ebreak', 'c.ebreak'}
+# Mnemonics of control transfer instructions. Bitmanip instructions such as
+# `bset` share the `b` prefix of branches, so these are listed in full.
+CONTROL_MNEMONICS = {
+    'beq', 'bne', 'blt', 'bge', 'bltu', 'bgeu', 'c.beqz', 'c.bnez', 'jal',
+    'jalr', 'c.j', 'c.jal', 'c.jr', 'c.jalr', 'mret', 'dret'
+}
+TRACE_HEADER = 'Time\t'
+
+
+class Instruction:
+    '''A retired instruction, parsed from a line of the trace.'''
+    __slots__ = ('cycle', 'pc', 'size', 'mnemonic', 'is_call')
+
+    def __init__(self, line):
+        fields = line.split('\t')
+        if len(fields) < 5:
+            raise ValueError('Malformed trace line: {!r}'.format(line))
+        self.cycle = int(fields[1])
+        self.pc = int(fields[2], 16)
+        # Compressed instructions are logged as four hex digits.
+        self.size = len(fields[3].strip()) // 2
+        self.mnemonic = fields[4].strip()
+        operands = fields[5] if len(fields) > 5 else ''
+        self.is_call = (self.mnemonic in LINK_MNEMONICS or
+                        (self.mnemonic in JUMP_MNEMONICS and
+                         operands.startswith('x1,')))
+
+    def next_pc(self):
+        return self.pc + self.size
+
+    def is_trap(self):
+        return self.mnemonic in TRAP_MNEMONICS
+
+    def is_control_transfer(self):
+        return self.mnemonic in CONTROL_MNEMONICS
+
+
+def read_trace(trace_file):
+    '''Yields the instructions of a trace, in the order they retired.'''
+    for line in trace_file:
+        line = line.rstrip('\n')
+        if not line or line.startswith(TRACE_HEADER):
+            continue
+        yield Instruction(line)
+
+
+class SymbolTable:
+    '''Maps addresses to the names of the functions that contain them.'''
+
+    def __init__(self, symbols):
+        '''Creates a symbol table from (address, size, name) tuples.
+
+        A symbol with a size of zero extends to the next symbol.'''
+        symbols = sorted(symbols)
+        self._addrs = [addr for addr, _, _ in symbols]
+        self._symbols = symbols
+        self._cache = {}
+
+    @classmethod
+    def from_elf(cls, elf_file):
+        '''Reads the function symbols of an ELF file.
+
+        Untyped symbols in executable sections are included as well, so that
+        assembly routines without a `.type` directive are named.'''
+        elf = elffile.ELFFile(elf_file)
+        symtab = elf.get_section_by_name('.symtab')
+        if symtab is None:
+            raise ValueError('{} has no symbol table'.format(elf_file.name))
+        symbols = {}
+        for symbol in symtab.iter_symbols():
+            sym_type = symbol['st_info']['type']
+            shndx = symbol['st_shndx']
+            if not symbol.name or not isinstance(shndx, int):
+                continue
+            if sym_type == 'STT_NOTYPE':
+                # Skip local labels, and symbols outside executable sections.
+                section = elf.get_section(shndx)
+                if (symbol.name.startswith('.L') or
+                        not section['sh_flags'] & 0x4):
+                    continue
+            elif sym_type != 'STT_FUNC':
+                continue
+            addr = symbol['st_value']
+            # Prefer typed functions over labels at the same address.
+            if addr not in symbols or sym_type == 'STT_FUNC':
+                symbols[addr] = (addr, symbol['st_size'], symbol.name)
+        return cls(symbols.values())
+
+    def lookup(self, addr):
+        '''Returns the name of the function containing `addr`.'''
+        name = self._cache.get(addr)
+        if name is not None:
+            return name
+        index = bisect.bisect_right(self._addrs, addr) - 1
+        name = '0x{:08x}'.format(addr)
+        if index >= 0:
+            start, size, sym_name = self._symbols[index]
+            if size == 0 or addr < start + size:
+                name = sym_name
+        self._cache[addr] = name
+        return name
+
+
+class Frame:
+    '''An entry of the shadow call stack.'''
+    __slots__ = ('function', 'caller', 'return_pc', 'entry_cycle', 'is_trap')
+
+    def __init__(self, function, caller, return_pc, entry_cycle, is_trap):
+        self.function = function
+        self.caller = caller
+        self.return_pc = return_pc
+        self.entry_cycle = entry_cycle
+        self.is_trap = is_trap
+
+
+class Profile:
+    '''Accumulates the per-function profile of a trace.'''
+
+    def __init__(self, symbols, root=None):
+        self.symbols = symbols
+        self.root = root
+        self.total_cycles = 0
+        self.total_instructions = 0
+        self.self_cycles = collections.Counter()
+        self.instructions = collections.Counter()
+        self.total = collections.Counter()
+        self.calls = collections.Counter()
+        self.edge_calls = collections.Counter()
+        self.edge_total = collections.Counter()
+        self._stack = []
+        # Number of frames of each function and of each call edge on the
+        # stack, so that the time spent in recursive calls is counted once.
+        self._active = collections.Counter()
+        self._active_edges = collections.Counter()
+
+    def _counting(self):
+        return self.root is None or self._active[self.root] > 0
+
+    def _push(self, function, caller, return_pc, cycle, is_trap=False):
+        self._stack.append(Frame(function, caller, return_pc, cycle, is_trap))
+        self._active[function] += 1
+        if caller is not None:
+            self._active_edges[(caller, function)] += 1
+            if self._counting():
+                self.calls[function] += 1
+                self.edge_calls[(caller, function)] += 1
+
+    def _pop(self, cycle):
+        frame = self._stack.pop()
+        counting = self._counting()
+        edge = (frame.caller, frame.function)
+        self._active[frame.function] -= 1
+        if counting and self._active[frame.function] == 0:
+            self.total[frame.function] += cycle - frame.entry_cycle
+        if frame.caller is not None:
+            self._active_edges[edge] -= 1
+            if counting and self._active_edges[edge] == 0:
+                self.edge_total[edge] += cycle - frame.entry_cycle
+        return frame
+
+    def _return_depth(self, pc):
+        '''Returns the depth of the innermost frame that returns to `pc`.'''
+        for depth in range(len(self._stack) - 1, 0, -1):
+            if self._stack[depth].return_pc == pc:
+                return depth
+        return None
+
+    def _trap_depth(self):
+        '''Returns the depth of the innermost trap frame.'''
+        for depth in range(len(self._stack) - 1, 0, -1):
+            if self._stack[depth].is_trap:
+                return depth
+        return None
+
+    def _transfer(self, insn, next_insn):
+        '''Updates the call stack for the control flow from `insn`.'''
+        pc = next_insn.pc
+        cycle = next_insn.cycle
+        top = self._stack[-1]
+        function = self.symbols.lookup(pc)
+
+        if insn.is_call:
+            self._push(function, top.function, insn.next_pc(), cycle)
+            return
+
+        if pc != insn.next_pc():
+            if insn.mnemonic == 'mret':
+                depth = self._trap_depth()
+            elif insn.is_trap() or not insn.is_control_transfer():
+                # An exception, or an interrupt taken after `insn`.
+                self._push(function, top.function, None, cycle, is_trap=True)
+                return
+            else:
+                depth = self._return_depth(pc)
+            if depth is not None:
+                while len(self._stack) > depth:
+                    self._pop(cycle)
+                top = self._stack[-1]
+
+        if function != top.function:
+            # A tail call, or a function that falls through into the next one.
+            # The new function replaces the current frame, and appears as
+            # called by the caller of the current frame.
+            if len(self._stack) == 1:
+                self._pop(cycle)
+                self._push(function, None, None, cycle)
+            else:
+                frame = self._pop(cycle)
+                self._push(function, frame.caller, frame.return_pc, cycle,
+                           frame.is_trap)
+
+    def add_trace(self, instructions):
+        '''Adds the instructions of a trace to the profile.'''
+        insn = next(instructions, None)
+        if insn is None:
+            return
+        self._push(self.symbols.lookup(insn.pc), None, None, insn.cycle)
+        for next_insn in instructions:
+            self._retire(insn, next_insn.cycle - insn.cycle)
+            self._transfer(insn, next_insn)
+            insn = next_insn
+        # The cost of the last instruction is unknown, count a single cycle.
+        self._retire(insn, 1)
+        while self._stack:
+            self._pop(insn.cycle + 1)
+
+    def _retire(self, insn, cycles):
+        if not self._counting():
+            return
+        function = self._stack[-1].function
+        self.self_cycles[function] += cycles
+        self.instructions[function] += 1
+        self.total_cycles += cycles
+        self.total_instructions += 1
+
+
+def percent(cycles, total):
+    return 100.0 * cycles / total if total else 0.0
+
+
+def print_flat_profile(profile, limit, out):
+    total = profile.total_cycles
+    print('Flat profile: {} cycles, {} instructions'.format(
+        total, profile.total_instructions),
+          file=out)
+    print(file=out)
+    print('{:>7} {:>12} {:>12} {:>12} {:>6} {:>8}  {}'.format(
+        '%self', 'self', 'total', 'insns', 'CPI', 'calls', 'function'),
+          file=out)
+    for function, cycles in profile.self_cycles.most_common(limit):
+        insns = profile.instructions[function]
+        print('{:>7.2f} {:>12} {:>12} {:>12} {:>6.2f} {:>8}  {}'.format(
+            percent(cycles, total), cycles, profile.total[function], insns,
+            cycles / insns, profile.calls[function], function),
+              file=out)
+
+
+def print_call_graph(profile, limit, out):
+    total = profile.total_cycles
+    callers = collections.defaultdict(list)
+    callees = collections.defaultdict(list)
+    for (caller, callee), calls in profile.edge_calls.items():
+        cycles = profile.edge_total[(caller, callee)]
+        callers[callee].append((cycles, calls, caller))
+        callees[caller].append((cycles, calls, callee))
+
+    print('Call graph: callers are listed above each function, and callees '
+          'below it', file=out)
+    print(file=out)
+    print('{:>8} {:>11} {:>12} {:>8}  {}'.format('%total', 'self', 'total',
+                                                 'calls', 'function'),
+          file=out)
+    for function, cycles in profile.total.most_common(limit):
+        print(file=out)
+        for edge_cycles, calls, caller in sorted(callers[function],
+                                                 reverse=True):
+            print('{:>20} {:>12} {:>8}      {}'.format('', edge_cycles, calls,
+                                                       caller),
+                  file=out)
+        print('{:>7.2f}% {:>11} {:>12} {:>8}  {}'.format(
+            percent(cycles, total), profile.self_cycles[function], cycles,
+            profile.calls[function], function),
+              file=out)
+        for edge_cycles, calls, callee in sorted(callees[function],
+                                                 reverse=True):
+            print('{:>20} {:>12} {:>8}      {}'.format('', edge_cycles, calls,
+                                                       callee),
+                  file=out)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--elf',
+                        '-e',
+                        required=True,
+                        type=argparse.FileType('rb'),
+                        help='ELF file of the software that was run.')
+    parser.add_argument('--trace',
+                        '-t',
+                        required=True,
+                        type=argparse.FileType('r'),
+                        help='Ibex trace log, e.g. trace_core_00000000.log.')
+    parser.add_argument('--root',
+                        '-r',
+                        help='Only profile the instructions executed while '
+                        'this function is on the call stack, e.g. `iterate` '
+                        'for CoreMark or `test_main` for OTTF tests.')
+    parser.add_argument('--limit',
+                        '-n',
+                        type=int,
+                        default=None,
+                        help='Maximum number of functions in each report.')
+    parser.add_argument('--no-call-graph',
+                        action='store_true',
+                        help='Only print the flat profile.')
+    parser.add_argument('--output',
+                        '-o',
+                        type=argparse.FileType('w'),
+                        default=sys.stdout,
+                        help='Output file, standard output by default.')
+    args = parser.parse_args()
+
+    symbols = SymbolTable.from_elf(args.elf)
+    profile = Profile(symbols, args.root)
+    profile.add_trace(read_trace(args.trace))
+    if profile.total_instructions == 0:
+        if args.root is not None:
+            print('Function {} was not executed.'.format(args.root),
+                  file=sys.stderr)
+        else:
+            print('The trace is empty.', file=sys.stderr)
+        return 1
+
+    print_flat_profile(profile, args.limit, args.output)
+    if not args.no_call_graph:
+        print(file=args.output)
+        print_call_graph(profile, args.limit, args.output)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())